@@ -31,6 +31,11 @@ if __name__ == "__main__":
     parser.add_argument(
         "--chunk_size", type=int, help="Chunk size for rendering (gsplat only)"
     )
+    parser.add_argument(
+        "--sh_codebook",
+        type=int,
+        help="SH codebook size of compress_sh (splatstream only)",
+    )
     args = parser.parse_args()
 
     ply_path = args.ply_path
@@ -51,7 +56,7 @@ if __name__ == "__main__":
     if target == "splatstream":
         from draw_splatstream import draw_splatstream
 
-        result = draw_splatstream(ply_data, draw_data)
+        result = draw_splatstream(ply_data, draw_data, sh_codebook=args.sh_codebook)
     elif target == "gsplat":
         from draw_gsplat import draw_gsplat
 
@@ -0,0 +1,91 @@
+import argparse
+import time
+
+import numpy as np
+
+from splatstream import _core
+
+from common import orbit_cameras, random_splats, vulkan_matrices
+
+
+def measure_fps(renderer, splats, views, projections, width, height, batch):
+    count = len(views)
+    images = np.empty((count, height, width, 4), dtype=np.uint8)
+    background = np.zeros(3, dtype=np.float32)
+
+    def draw():
+        if batch:
+            rendered_images = [
+                renderer.draw_batch(
+                    splats,
+                    views,
+                    projections,
+                    width,
+                    height,
+                    np.zeros((count, 3), dtype=np.float32),
+                    np.full(count, 0.3, dtype=np.float32),
+                    np.full(count, -1, dtype=np.int32),
+                    np.zeros(count, dtype=bool),
+                    images,
+                )
+            ]
+        else:
+            # One draw per view, all submitted before waiting on any.
+            rendered_images = [
+                renderer.draw(
+                    splats,
+                    views[i],
+                    projections[i],
+                    width,
+                    height,
+                    background,
+                    0.3,
+                    -1,
+                    images[i],
+                )
+                for i in range(count)
+            ]
+        for rendered_image in rendered_images:
+            rendered_image.wait()
+
+    # Warm up, then time all views.
+    draw()
+    start_time = time.time()
+    draw()
+    return count / (time.time() - start_time)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--depths",
+        type=int,
+        nargs="+",
+        default=[1, 2, 3, 4],
+        help="Frames in flight of the renderer",
+    )
+    parser.add_argument("--count", type=int, default=10_000_000)
+    parser.add_argument("--views", type=int, default=128)
+    parser.add_argument("--width", type=int, default=1280)
+    parser.add_argument("--height", type=int, default=720)
+    args = parser.parse_args()
+
+    viewmats, Ks = orbit_cameras(args.views, args.width, args.height)
+    views, projections = vulkan_matrices(viewmats, Ks, args.width, args.height)
+
+    print("| frames in flight | draw FPS | draw_batch FPS |")
+    print("|:----------------:|:--------:|:--------------:|")
+    for depth in args.depths:
+        renderer = _core.Renderer(frames_in_flight=depth)
+        splats = random_splats(args.count, renderer=renderer)
+        splats.wait()
+        fps_draw = measure_fps(
+            renderer, splats, views, projections, args.width, args.height, False
+        )
+        fps_batch = measure_fps(
+            renderer, splats, views, projections, args.width, args.height, True
+        )
+        del splats
+        del renderer
+
+        print(f"| {depth} | {fps_draw:.2f} | {fps_batch:.2f} |")
@@ -0,0 +1,56 @@
+import argparse
+import time
+
+import splatstream as ss
+
+from common import orbit_cameras, random_splats
+
+
+def measure_fps(splats, viewmats, Ks, width, height):
+    # Warm up, then time one batch of views.
+    ss.draw(splats, viewmats[:1], Ks[:1], width, height).numpy()
+    start_time = time.time()
+    ss.draw(splats, viewmats, Ks, width, height).numpy()
+    return len(viewmats) / (time.time() - start_time)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--counts",
+        type=int,
+        nargs="+",
+        default=[1_000_000, 10_000_000, 50_000_000],
+        help="Numbers of random splats",
+    )
+    parser.add_argument("--views", type=int, default=64)
+    parser.add_argument("--width", type=int, default=1280)
+    parser.add_argument("--height", type=int, default=720)
+    args = parser.parse_args()
+
+    viewmats, Ks = orbit_cameras(args.views, args.width, args.height)
+
+    print("| #splats | separate FPS | reordered FPS | interleaved FPS |")
+    print("|:-------:|:------------:|:-------------:|:---------------:|")
+    for count in args.counts:
+        splats = random_splats(count)
+        splats.wait()
+        fps_separate = measure_fps(splats, viewmats, Ks, args.width, args.height)
+
+        reordered = ss.reorder(splats)
+        del splats
+        reordered.wait()
+        fps_reordered = measure_fps(reordered, viewmats, Ks, args.width, args.height)
+
+        interleaved = ss.interleave(reordered)
+        del reordered
+        interleaved.wait()
+        fps_interleaved = measure_fps(
+            interleaved, viewmats, Ks, args.width, args.height
+        )
+        del interleaved
+
+        print(
+            f"| {count:,} | {fps_separate:.2f} | {fps_reordered:.2f} "
+            f"| {fps_interleaved:.2f} |"
+        )
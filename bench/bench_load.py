@@ -0,0 +1,78 @@
+import argparse
+import glob
+import os
+import sys
+import time
+
+import splatstream as ss
+
+
+def peak_rss():
+    # Peak resident set size of the process so far in bytes, None where unavailable.
+    try:
+        import resource
+    except ImportError:
+        return None
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak if sys.platform == "darwin" else peak * 1024
+
+
+def warm_up_loop(paths):
+    start_time = time.time()
+    splats = [ss.load_from_ply(path) for path in paths]
+    for s in splats:
+        s.wait()
+    return time.time() - start_time, splats
+
+
+def warm_up_bulk(paths):
+    start_time = time.time()
+    splats = ss.load_many_from_ply(paths)
+    for s in splats:
+        s.wait()
+    return time.time() - start_time, splats
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "paths", type=str, nargs="+", help="PLY files, or directories of PLY files"
+    )
+    parser.add_argument(
+        "--repeat", type=int, default=1, help="Repeat the scene list N times"
+    )
+    parser.add_argument(
+        "--target",
+        type=str,
+        choices=["loop", "bulk", "both"],
+        default="both",
+        help="load_from_ply in a loop, load_many_from_ply, or both.",
+    )
+    args = parser.parse_args()
+
+    paths = []
+    for path in args.paths:
+        if os.path.isdir(path):
+            paths += sorted(glob.glob(os.path.join(path, "*.ply")))
+        else:
+            paths.append(path)
+    paths = paths * args.repeat
+    total_bytes = sum(os.path.getsize(path) for path in paths)
+
+    print(f"#scenes: {len(paths)}")
+    print(f"total size: {total_bytes / 1e9:.2f} GB")
+
+    targets = ["loop", "bulk"] if args.target == "both" else [args.target]
+    for target in targets:
+        warm_up = warm_up_loop if target == "loop" else warm_up_bulk
+        elapsed, splats = warm_up(paths)
+        points = sum(s.size for s in splats)
+        del splats
+        # The peak covers the whole process, so run one target at a time to compare.
+        peak = peak_rss()
+        print(
+            f"{target}: {elapsed:.3f} s, "
+            f"{total_bytes / 1e9 / elapsed:.2f} GB/s, "
+            f"{points / 1e6 / elapsed:.2f} M points/s"
+            + (f", peak RSS {peak / 1e9:.2f} GB" if peak is not None else "")
+        )
@@ -0,0 +1,81 @@
+import argparse
+import time
+
+from PIL import Image
+import numpy as np
+
+import splatstream as ss
+
+from bench import calculate_psnr
+from common import load_colmap_data
+
+
+def draw(splats, draw_data):
+    start_time = time.time()
+    images = ss.draw(
+        splats=splats,
+        viewmats=draw_data["viewmats"],
+        Ks=draw_data["Ks"],
+        width=draw_data["width"],
+        height=draw_data["height"],
+        near=0.1,
+        far=1e3,
+    ).numpy()
+    return time.time() - start_time, images[..., :3]
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--ply_path", type=str)
+    parser.add_argument("--colmap_path", type=str)
+    parser.add_argument("--scale", type=float, default=1.0)
+    parser.add_argument(
+        "--first", type=int, help="First N images to benchmark (debugging)"
+    )
+    args = parser.parse_args()
+
+    print("loading colmap data...")
+    draw_data = load_colmap_data(args.colmap_path, scale=args.scale, first=args.first)
+
+    print("loading splats...")
+    splats = ss.load_from_ply(args.ply_path)
+    splats.wait()
+    size = ss.residency_stats()["resident_size"]
+    quantized = ss.quantize(splats)
+    quantized.wait()
+    quantized_size = ss.residency_stats()["resident_size"] - size
+
+    # Warm up both paths before timing.
+    draw(splats, draw_data)
+    draw(quantized, draw_data)
+    time_fp32, images_fp32 = draw(splats, draw_data)
+    time_quantized, images_quantized = draw(quantized, draw_data)
+
+    # Differences against the fp32 path, and against ground truth.
+    diff_psnrs = []
+    max_diffs = []
+    gt_psnrs_fp32 = []
+    gt_psnrs_quantized = []
+    for i in range(len(images_fp32)):
+        img0 = images_fp32[i]
+        img1 = images_quantized[i]
+        diff_psnrs.append(calculate_psnr(img0, img1))
+        max_diffs.append(np.max(np.abs(img0.astype(np.int32) - img1.astype(np.int32))))
+        gt = np.array(Image.open(draw_data["image_paths"][i]))
+        gt_psnrs_fp32.append(calculate_psnr(gt, img0))
+        gt_psnrs_quantized.append(calculate_psnr(gt, img1))
+
+    count = len(images_fp32)
+    print(f"#imgs: {count}")
+    print(f"VRAM fp32: {size / 2**20:.1f} MiB")
+    print(f"VRAM quantized: {quantized_size / 2**20:.1f} MiB")
+    print(
+        f"PSNR quantized vs fp32: {np.mean(diff_psnrs):.2f} ± {np.std(diff_psnrs):.2f}"
+    )
+    print(f"Max abs diff: {np.max(max_diffs)}")
+    print(f"PSNR fp32: {np.mean(gt_psnrs_fp32):.2f} ± {np.std(gt_psnrs_fp32):.2f}")
+    print(
+        f"PSNR quantized: {np.mean(gt_psnrs_quantized):.2f} ± {np.std(gt_psnrs_quantized):.2f}"
+    )
+    print(f"FPS fp32: {count / time_fp32:.2f}")
+    print(f"FPS quantized: {count / time_quantized:.2f}")
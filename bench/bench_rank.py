@@ -0,0 +1,48 @@
+import argparse
+
+import splatstream as ss
+
+from common import orbit_cameras, random_splats
+
+
+def measure_rank_time(splats, viewmats, Ks, width, height):
+    # Warm up, then average the GPU time of the rank pass over all views, one draw each.
+    ss.draw(splats, viewmats[:1], Ks[:1], width, height).numpy()
+    before = ss.timing_stats()
+    for i in range(len(viewmats)):
+        ss.draw(splats, viewmats[i : i + 1], Ks[i : i + 1], width, height).numpy()
+    after = ss.timing_stats()
+    count = after["rank_count"] - before["rank_count"]
+    if count == 0:
+        return None
+    return (after["rank_time"] - before["rank_time"]) / count / 1e6
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--counts",
+        type=int,
+        nargs="+",
+        default=[1_000_000, 10_000_000, 50_000_000],
+        help="Numbers of random splats",
+    )
+    parser.add_argument("--views", type=int, default=16)
+    parser.add_argument("--width", type=int, default=1280)
+    parser.add_argument("--height", type=int, default=720)
+    args = parser.parse_args()
+
+    viewmats, Ks = orbit_cameras(args.views, args.width, args.height)
+
+    print("| #splats | rank ms |")
+    print("|:-------:|:-------:|")
+    for count in args.counts:
+        splats = random_splats(count)
+        splats.wait()
+        rank_ms = measure_rank_time(splats, viewmats, Ks, args.width, args.height)
+        del splats
+
+        if rank_ms is None:
+            print(f"| {count:,} | no timestamp queries on the compute queue |")
+        else:
+            print(f"| {count:,} | {rank_ms:.3f} |")
@@ -0,0 +1,59 @@
+import argparse
+
+import numpy as np
+
+from splatstream import _core
+
+from common import orbit_cameras, random_splats, vulkan_matrices
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--counts",
+        type=int,
+        nargs="+",
+        default=[1_000_000, 10_000_000, 50_000_000],
+        help="Numbers of random splats",
+    )
+    parser.add_argument("--width", type=int, default=1280)
+    parser.add_argument("--height", type=int, default=720)
+    args = parser.parse_args()
+
+    viewmats, Ks = orbit_cameras(1, args.width, args.height)
+    views, projections = vulkan_matrices(viewmats, Ks, args.width, args.height)
+    image = np.empty((args.height, args.width, 4), dtype=np.uint8)
+    background = np.zeros(3, dtype=np.float32)
+
+    print(
+        "| #splats | unaliased MB | aliased MB | unaliased B/splat | aliased B/splat |"
+    )
+    print(
+        "|:-------:|:------------:|:----------:|:-----------------:|:---------------:|"
+    )
+    for count in args.counts:
+        # A new renderer of one frame in flight, so that its scratch holds one draw of
+        # count splats.
+        renderer = _core.Renderer(frames_in_flight=1)
+        splats = random_splats(count, renderer=renderer)
+        splats.wait()
+        renderer.draw(
+            splats,
+            views[0],
+            projections[0],
+            args.width,
+            args.height,
+            background,
+            0.3,
+            -1,
+            image,
+        ).wait()
+        memory_stats = renderer.memory_stats()
+        unaliased = memory_stats["sort_scratch_unaliased"]
+        aliased = memory_stats["sort_scratch"]["device"]
+        del splats
+        del renderer
+
+        print(
+            f"| {count:,} | {unaliased / 1e6:.1f} | {aliased / 1e6:.1f} "
+            f"| {unaliased / count:.1f} | {aliased / count:.1f} |"
+        )
@@ -3,6 +3,8 @@ import math
 import numpy as np
 from plyfile import PlyData
 
+import splatstream as ss
+
 from scene.dataset_readers import readColmapSceneInfo
 
 
@@ -94,3 +96,65 @@ def load_colmap_data(colmap_path: str, scale: float = 1.0, first: int | None = N
         "height": height,
         "image_paths": image_paths,
     }
+
+
+def random_splats(count, seed=0, renderer=None):
+    """
+    renderer: _core.Renderer to create the splats in. The singleton renderer if None.
+    """
+    rng = np.random.default_rng(seed)
+    means = rng.uniform(-1.0, 1.0, (count, 3)).astype(np.float32)
+    quats = rng.normal(size=(count, 4))
+    quats = (quats / np.linalg.norm(quats, axis=-1, keepdims=True)).astype(np.float32)
+    scales = rng.uniform(0.001, 0.01, (count, 3)).astype(np.float32)
+    opacities = rng.uniform(0.1, 1.0, count).astype(np.float32)
+    colors = rng.uniform(-0.5, 0.5, (count, 1, 3)).astype(np.float16)
+    if renderer is None:
+        return ss.gaussian_splats(
+            means=means, quats=quats, scales=scales, opacities=opacities, colors=colors
+        )
+    return renderer.create_gaussian_splats(means, quats, scales, opacities, colors, 0)
+
+
+def orbit_cameras(view_count, width, height, distance=3.0, fov=math.radians(60)):
+    viewmats = []
+    for i in range(view_count):
+        theta = 2 * math.pi * i / view_count
+        # Camera on a circle around the origin, looking at it (+z forward).
+        R = np.array(
+            [
+                [math.cos(theta), 0.0, -math.sin(theta)],
+                [0.0, 1.0, 0.0],
+                [math.sin(theta), 0.0, math.cos(theta)],
+            ]
+        )
+        W2C = np.eye(4)
+        W2C[:3, :3] = R
+        W2C[:3, 3] = [0.0, 0.0, distance]
+        viewmats.append(W2C)
+
+    K = np.zeros((3, 3))
+    K[0, 0] = width / (2 * math.tan(fov / 2))
+    K[1, 1] = K[0, 0]
+    K[0, 2] = width / 2
+    K[1, 2] = height / 2
+    K[2, 2] = 1
+    return np.stack(viewmats), np.stack([K] * view_count)
+
+
+def vulkan_matrices(viewmats, Ks, width, height, near=0.01, far=100.0):
+    # Same conversion as splatstream.draw, for calling the renderer directly.
+    viewmats = (
+        np.array([[1, 0, 0, 0], [0, -1, 0, 0], [0, 0, -1, 0], [0, 0, 0, 1]]) @ viewmats
+    )
+    Ks = np.array([[2.0 / width, 0, -1], [0, -2.0 / height, 1], [0, 0, 1]]) @ Ks
+    projections = np.insert(Ks, 2, 0, axis=-1)
+    projections = np.insert(projections, 2, 0, axis=-2)
+    projections[..., 2, 2] = far / (near - far)
+    projections[..., 2, 3] = near * far / (near - far)
+    projections[..., 3, 2] = -1
+    projections[..., 3, 3] = 0
+    return (
+        np.ascontiguousarray(viewmats, dtype=np.float32),
+        np.ascontiguousarray(projections, dtype=np.float32),
+    )
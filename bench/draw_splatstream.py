@@ -3,7 +3,7 @@ import time
 import splatstream as ss
 
 
-def draw_splatstream(ply_data, draw_data):
+def draw_splatstream(ply_data, draw_data, sh_codebook=None):
     print("loading splats...")
     splats = ss.gaussian_splats(
         means=ply_data["means"],
@@ -12,6 +12,8 @@ def draw_splatstream(ply_data, draw_data):
         opacities=ply_data["opacities"],
         colors=ply_data["colors"],
     )
+    if sh_codebook is not None:
+        splats = ss.compress_sh(splats, sh_codebook)
     # Wait for CPU -> GPU, to measure rendering time only
     splats.wait()
     print("loading splats done")
@@ -1,5 +1,13 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "vkgs/renderer.h"
 #include "vkgs/gaussian_splats.h"
@@ -7,33 +15,168 @@
 
 namespace py = pybind11;
 
+namespace {
+
+// Read-only inputs are cast to dense arrays of T, copying if needed.
+template <typename T>
+using InputArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+// Images are written after the call returns, so they must be the caller's own dense uint8 array, never a copy. Bound
+// with noconvert.
+using OutputArray = py::array_t<uint8_t, py::array::c_style>;
+
+// References to Python objects held by C++ past a call, such as arrays read by a pending upload. The last holder may
+// drop them on any thread, possibly while holding the renderer mutex that a thread holding the GIL waits for, so they
+// are released right away only if the GIL is held and otherwise at the next call that holds it.
+std::mutex released_mutex;
+std::vector<PyObject*> released;
+
+std::shared_ptr<void> Hold(py::object object) {
+  return std::shared_ptr<void>(object.release().ptr(), [](void* ptr) {
+    auto* object = static_cast<PyObject*>(ptr);
+    if (PyGILState_Check()) {
+      Py_DECREF(object);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(released_mutex);
+    released.push_back(object);
+  });
+}
+
+// Releases references dropped without the GIL. Called with the GIL held.
+void ReleaseDropped() {
+  std::vector<PyObject*> objects;
+  {
+    std::lock_guard<std::mutex> lock(released_mutex);
+    objects.swap(released);
+  }
+  for (auto* object : objects) Py_DECREF(object);
+}
+
+void CheckShape(const py::array& array, std::initializer_list<py::ssize_t> shape, const char* name) {
+  bool valid = array.ndim() == static_cast<py::ssize_t>(shape.size());
+  for (size_t i = 0; valid && i < shape.size(); ++i) valid = array.shape(i) == shape.begin()[i];
+  if (!valid) {
+    std::string expected;
+    for (auto size : shape) expected += (expected.empty() ? "" : ", ") + std::to_string(size);
+    std::string actual;
+    for (py::ssize_t i = 0; i < array.ndim(); ++i) actual += (i == 0 ? "" : ", ") + std::to_string(array.shape(i));
+    throw py::value_error(std::string(name) + " must have shape (" + expected + "), got (" + actual + ")");
+  }
+}
+
+}  // namespace
+
 PYBIND11_MODULE(_core, m) {
   py::class_<vkgs::Renderer>(m, "Renderer")
       .def(py::init<>())
+      .def(py::init<uint32_t>(), py::arg("frames_in_flight"))
       .def_property_readonly("device_name", &vkgs::Renderer::device_name)
       .def_property_readonly("graphics_queue_index", &vkgs::Renderer::graphics_queue_index)
       .def_property_readonly("compute_queue_index", &vkgs::Renderer::compute_queue_index)
       .def_property_readonly("transfer_queue_index", &vkgs::Renderer::transfer_queue_index)
+      .def("create_sharing_scratch", &vkgs::Renderer::CreateSharingScratch)
       .def("load_from_ply", &vkgs::Renderer::LoadFromPly)
-      .def("create_gaussian_splats",
-           [](vkgs::Renderer& renderer, py::array_t<float> means, py::array_t<float> quats, py::array_t<float> scales,
-              py::array_t<float> opacities, intptr_t colors_ptr, int sh_degree) {
-             size_t N = means.shape(0);
-             const auto* means_ptr = static_cast<const float*>(means.request().ptr);
-             const auto* quats_ptr = static_cast<const float*>(quats.request().ptr);
-             const auto* scales_ptr = static_cast<const float*>(scales.request().ptr);
-             const auto* opacities_ptr = static_cast<const float*>(opacities.request().ptr);
-             const auto* colors_u16_ptr = reinterpret_cast<const uint16_t*>(colors_ptr);
-             return renderer.CreateGaussianSplats(N, means_ptr, quats_ptr, scales_ptr, opacities_ptr, colors_u16_ptr,
-                                                  sh_degree);
+      .def("load_many_from_ply", &vkgs::Renderer::LoadManyFromPly)
+      .def("save_splats", &vkgs::Renderer::SaveSplats)
+      .def("load_splats", &vkgs::Renderer::LoadSplats)
+      .def("reorder", &vkgs::Renderer::Reorder)
+      .def("quantize", &vkgs::Renderer::Quantize)
+      .def("interleave", &vkgs::Renderer::Interleave)
+      .def("compress_sh", &vkgs::Renderer::CompressSh)
+      .def("set_memory_budget", &vkgs::Renderer::SetMemoryBudget)
+      .def("residency_stats",
+           [](vkgs::Renderer& renderer) {
+             auto stats = renderer.GetResidencyStats();
+             py::dict result;
+             result["hits"] = stats.hits;
+             result["misses"] = stats.misses;
+             result["evictions"] = stats.evictions;
+             result["resident_count"] = stats.resident_count;
+             result["resident_size"] = stats.resident_size;
+             result["evicted_count"] = stats.evicted_count;
+             result["evicted_size"] = stats.evicted_size;
+             return result;
+           })
+      .def("memory_stats",
+           [](vkgs::Renderer& renderer) {
+             auto stats = renderer.GetMemoryStats();
+             auto usage = [](const vkgs::MemoryUsage& usage) {
+               py::dict result;
+               result["device"] = usage.device;
+               result["host"] = usage.host;
+               return result;
+             };
+             py::dict result;
+             result["splats"] = usage(stats.splats);
+             result["sort_scratch"] = usage(stats.sort_scratch);
+             result["sort_scratch_unaliased"] = stats.sort_scratch_unaliased;
+             result["images"] = usage(stats.images);
+             result["staging"] = usage(stats.staging);
+             result["readback"] = usage(stats.readback);
+             result["other"] = usage(stats.other);
+             result["pending_retire"] = usage(stats.pending_retire);
+             result["allocated"] = usage(stats.allocated);
+             result["reserved"] = usage(stats.reserved);
+             py::list splats_objects;
+             for (const auto& splats : stats.splats_objects) {
+               py::dict splats_memory;
+               splats_memory["point_count"] = splats.point_count;
+               splats_memory["sh_degree"] = splats.sh_degree;
+               splats_memory["resident"] = splats.resident;
+               splats_memory["size"] = splats.size;
+               splats_objects.append(splats_memory);
+             }
+             result["splats_objects"] = splats_objects;
+             return result;
            })
-      .def("draw", [](vkgs::Renderer& renderer, vkgs::GaussianSplats splats, py::array_t<float> view,
-                      py::array_t<float> projection, uint32_t width, uint32_t height, py::array_t<float> background,
-                      float eps2d, int sh_degree, py::array_t<uint8_t> dst, bool visualize_depth) {
-        const auto* background_ptr = static_cast<const float*>(background.request().ptr);
-        const auto* view_ptr = static_cast<const float*>(view.request().ptr);
-        const auto* projection_ptr = static_cast<const float*>(projection.request().ptr);
-        auto* dst_ptr = static_cast<uint8_t*>(dst.request().ptr);
+      .def("memory_stats_json", &vkgs::Renderer::GetMemoryStatsJson)
+      .def("timing_stats",
+           [](vkgs::Renderer& renderer) {
+             auto stats = renderer.GetTimingStats();
+             py::dict result;
+             result["rank_count"] = stats.rank_count;
+             result["rank_time"] = stats.rank_time;
+             result["rank_time_last"] = stats.rank_time_last;
+             return result;
+           })
+      .def("create_gaussian_splats",
+           [](vkgs::Renderer& renderer, InputArray<float> means, InputArray<float> quats, InputArray<float> scales,
+              InputArray<float> opacities, py::array colors, int sh_degree) {
+             ReleaseDropped();
+
+             // float16 has no C++ type for pybind11 to cast to, so colors must already be dense float16.
+             if (sh_degree < 0 || sh_degree > 3) throw py::value_error("sh_degree must be in [0, 3]");
+             if (colors.dtype().kind() != 'f' || colors.itemsize() != 2 || !(colors.flags() & py::array::c_style)) {
+               throw py::value_error("colors must be a C-contiguous float16 array");
+             }
+             if (means.ndim() != 2) throw py::value_error("means must have shape (N, 3)");
+             auto N = means.shape(0);
+             py::ssize_t K = (sh_degree + 1) * (sh_degree + 1);
+             CheckShape(means, {N, 3}, "means");
+             CheckShape(quats, {N, 4}, "quats");
+             CheckShape(scales, {N, 3}, "scales");
+             CheckShape(opacities, {N}, "opacities");
+             CheckShape(colors, {N, K, 3}, "colors");
+
+             // The device may read the arrays after returning, so the ones actually passed, possibly converted
+             // copies, are held until the upload is done.
+             auto owner = Hold(py::make_tuple(means, quats, scales, opacities, colors));
+             return renderer.CreateGaussianSplats(N, means.data(), quats.data(), scales.data(), opacities.data(),
+                                                  static_cast<const uint16_t*>(colors.data()), sh_degree, owner);
+           }, py::arg("means"), py::arg("quats"), py::arg("scales"), py::arg("opacities"),
+           py::arg("colors").noconvert(), py::arg("sh_degree"))
+      .def("draw", [](vkgs::Renderer& renderer, vkgs::GaussianSplats splats, InputArray<float> view,
+                      InputArray<float> projection, uint32_t width, uint32_t height, InputArray<float> background,
+                      float eps2d, int sh_degree, OutputArray dst, bool visualize_depth, bool sorted_projection) {
+        CheckShape(view, {4, 4}, "view");
+        CheckShape(projection, {4, 4}, "projection");
+        CheckShape(background, {3}, "background");
+        CheckShape(dst, {height, width, 4}, "dst");
+        const auto* background_ptr = background.data();
+        const auto* view_ptr = view.data();
+        const auto* projection_ptr = projection.data();
+        auto* dst_ptr = dst.mutable_data();
 
         vkgs::DrawOptions draw_options = {};
         // row-major data to column-major
@@ -49,10 +192,56 @@ PYBIND11_MODULE(_core, m) {
         draw_options.eps2d = eps2d;
         draw_options.sh_degree = sh_degree;
         draw_options.visualize_depth = visualize_depth;
+        draw_options.sorted_projection = sorted_projection;
         return renderer.Draw(splats, draw_options, dst_ptr);
       }, py::arg("splats"), py::arg("view"), py::arg("projection"), py::arg("width"), py::arg("height"),
-         py::arg("background"), py::arg("eps2d"), py::arg("sh_degree"), py::arg("dst"),
-         py::arg("visualize_depth") = false);
+         py::arg("background"), py::arg("eps2d"), py::arg("sh_degree"), py::arg("dst").noconvert(),
+         py::arg("visualize_depth") = false, py::arg("sorted_projection") = true, py::keep_alive<0, 10>())
+      .def("draw_batch", [](vkgs::Renderer& renderer, vkgs::GaussianSplats splats, InputArray<float> views,
+                            InputArray<float> projections, uint32_t width, uint32_t height,
+                            InputArray<float> backgrounds, InputArray<float> eps2d, InputArray<int> sh_degree,
+                            InputArray<bool> visualize_depth, OutputArray out, bool sorted_projection) {
+        // views, projections: (B, 4, 4), backgrounds: (B, 3), eps2d, sh_degree, visualize_depth: (B),
+        // out: (B, H, W, 4).
+        if (views.ndim() != 3) throw py::value_error("views must have shape (B, 4, 4)");
+        auto batch_size = views.shape(0);
+        CheckShape(views, {batch_size, 4, 4}, "views");
+        CheckShape(projections, {batch_size, 4, 4}, "projections");
+        CheckShape(backgrounds, {batch_size, 3}, "backgrounds");
+        CheckShape(eps2d, {batch_size}, "eps2d");
+        CheckShape(sh_degree, {batch_size}, "sh_degree");
+        CheckShape(visualize_depth, {batch_size}, "visualize_depth");
+        CheckShape(out, {batch_size, height, width, 4}, "out");
+        const auto* views_ptr = views.data();
+        const auto* projections_ptr = projections.data();
+        const auto* backgrounds_ptr = backgrounds.data();
+        const auto* eps2d_ptr = eps2d.data();
+        const auto* sh_degree_ptr = sh_degree.data();
+        const auto* visualize_depth_ptr = visualize_depth.data();
+        auto* out_ptr = out.mutable_data();
+
+        std::vector<vkgs::DrawOptions> draw_options(batch_size);
+        for (py::ssize_t i = 0; i < batch_size; ++i) {
+          auto& options = draw_options[i];
+          // row-major data to column-major
+          for (int r = 0; r < 4; ++r) {
+            for (int c = 0; c < 4; ++c) {
+              options.view[c * 4 + r] = views_ptr[i * 16 + r * 4 + c];
+              options.projection[c * 4 + r] = projections_ptr[i * 16 + r * 4 + c];
+            }
+          }
+          options.width = width;
+          options.height = height;
+          std::memcpy(options.background, backgrounds_ptr + i * 3, 3 * sizeof(float));
+          options.eps2d = eps2d_ptr[i];
+          options.sh_degree = sh_degree_ptr[i];
+          options.visualize_depth = visualize_depth_ptr[i];
+          options.sorted_projection = sorted_projection;
+        }
+        return renderer.DrawBatch(splats, draw_options, out_ptr);
+      }, py::arg("splats"), py::arg("views"), py::arg("projections"), py::arg("width"), py::arg("height"),
+         py::arg("backgrounds"), py::arg("eps2d"), py::arg("sh_degree"), py::arg("visualize_depth"),
+         py::arg("out").noconvert(), py::arg("sorted_projection") = true, py::keep_alive<0, 11>());
 
   py::class_<vkgs::GaussianSplats>(m, "GaussianSplats")
       .def_property_readonly("size", &vkgs::GaussianSplats::size)
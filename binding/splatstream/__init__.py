@@ -1,8 +1,36 @@
 from .singleton_renderer import singleton_renderer
-from .renderer import gaussian_splats, load_from_ply, draw
+from .renderer import (
+    gaussian_splats,
+    load_from_ply,
+    load_many_from_ply,
+    set_memory_budget,
+    residency_stats,
+    memory_stats,
+    dump_memory_stats,
+    timing_stats,
+    save_splats,
+    load_splats,
+    reorder,
+    quantize,
+    interleave,
+    compress_sh,
+    draw,
+)
 
 __all__ = [
     "gaussian_splats",
     "load_from_ply",
+    "load_many_from_ply",
+    "set_memory_budget",
+    "residency_stats",
+    "memory_stats",
+    "dump_memory_stats",
+    "timing_stats",
+    "save_splats",
+    "load_splats",
+    "reorder",
+    "quantize",
+    "interleave",
+    "compress_sh",
     "draw",
 ]
@@ -48,11 +48,8 @@ def gaussian_splats(
     colors = np.ascontiguousarray(colors, dtype=np.float16)
     opacities = np.ascontiguousarray(opacities, dtype=np.float32)
 
-    # float16 is not acceptable by pybind11, so pass the pointer instead.
-    colors_ptr = colors.ctypes.data
-
     return singleton_renderer.create_gaussian_splats(
-        means, quats, scales, opacities, colors_ptr, sh_degree
+        means, quats, scales, opacities, colors, sh_degree
     )
 
 
@@ -60,6 +57,103 @@ def load_from_ply(path: str, sh_degree: int = -1) -> _core.GaussianSplats:
     return singleton_renderer.load_from_ply(path, sh_degree)
 
 
+def load_many_from_ply(
+    paths: list[str], sh_degree: int = -1
+) -> list[_core.GaussianSplats]:
+    return singleton_renderer.load_many_from_ply(paths, sh_degree)
+
+
+def set_memory_budget(budget: int) -> None:
+    """
+    budget: device memory budget of splats in bytes. 0 uses the budget reported by the driver.
+
+    Least recently drawn splats are evicted to host memory when over budget, and uploaded
+    again on their next draw.
+    """
+    singleton_renderer.set_memory_budget(budget)
+
+
+def residency_stats() -> dict:
+    return singleton_renderer.residency_stats()
+
+
+def memory_stats() -> dict:
+    """
+    Device and host bytes by category: splats, sort_scratch, images, staging, readback,
+    other and pending_retire, with allocated and reserved totals from VMA and a list of
+    live splats in splats_objects. Pending retire memory is also counted in its category.
+    sort_scratch_unaliased is the device bytes sort_scratch would take without aliasing.
+    """
+    return singleton_renderer.memory_stats()
+
+
+def dump_memory_stats(path: str) -> None:
+    """
+    Writes memory_stats as JSON to path.
+    """
+    with open(path, "w") as f:
+        f.write(singleton_renderer.memory_stats_json())
+
+
+def timing_stats() -> dict:
+    """
+    GPU nanoseconds of the rank pass of finished draws: rank_count passes, rank_time in
+    total and rank_time_last of the last one. All zero if the device has no timestamp
+    queries on its compute queue.
+    """
+    return singleton_renderer.timing_stats()
+
+
+def save_splats(splats: _core.GaussianSplats, path: str) -> None:
+    singleton_renderer.save_splats(splats, path)
+
+
+def load_splats(path: str) -> _core.GaussianSplats:
+    return singleton_renderer.load_splats(path)
+
+
+def reorder(splats: _core.GaussianSplats) -> _core.GaussianSplats:
+    """
+    Returns a copy of splats sorted by the Morton code of their positions, so that splats
+    close in space are close in memory.
+
+    Reorder before quantize, interleave or compress_sh; their results cannot be reordered.
+    """
+    return singleton_renderer.reorder(splats)
+
+
+def quantize(splats: _core.GaussianSplats) -> _core.GaussianSplats:
+    """
+    Returns a copy of splats in compact storage: positions as float16 offsets from chunk
+    centers, covariances as float16 and opacities as uint8, about half the device memory.
+
+    Quantized splats are drawn as usual but cannot be saved with save_splats.
+    """
+    return singleton_renderer.quantize(splats)
+
+
+def interleave(splats: _core.GaussianSplats) -> _core.GaussianSplats:
+    """
+    Returns a copy of splats with position and opacity in one vec4 per splat and covariance
+    as a vec4 and a vec2, read with aligned vector loads when drawing.
+
+    Interleaved splats cannot be quantized or saved with save_splats.
+    """
+    return singleton_renderer.interleave(splats)
+
+
+def compress_sh(
+    splats: _core.GaussianSplats, codebook_size: int = 4096
+) -> _core.GaussianSplats:
+    """
+    Returns a copy of splats whose SH bands above DC are replaced by indices into a k-means
+    codebook of codebook_size entries, at most 65536. DC stays per splat.
+
+    Compressed splats are drawn as usual but cannot be saved with save_splats.
+    """
+    return singleton_renderer.compress_sh(splats, codebook_size)
+
+
 def draw(
     splats: _core.GaussianSplats,
     viewmats: np.ndarray,
@@ -72,6 +166,8 @@ def draw(
     eps2d: float | np.ndarray = 0.3,
     sh_degree: int | np.ndarray = -1,
     visualize_depth: bool | np.ndarray = False,
+    out: np.ndarray | None = None,
+    sorted_projection: bool = True,
 ) -> RenderedImage:
     """
     viewmats: (..., 4, 4)
@@ -82,6 +178,9 @@ def draw(
     eps2d: (...) or scalar
     sh_degree: (...) or scalar. -1 for max degree.
     visualize_depth: (...) or scalar. If True, visualize depth using a colormap instead of colors.
+    out: (..., height, width, 4) C-contiguous uint8 to draw into. Allocated if None.
+    sorted_projection: project visible splats in sorted order. If False, project all splats
+        in point order through an inverse index. Both draw the same images.
     """
     if isinstance(near, (int, float)):
         near = np.array(near)
@@ -132,8 +231,13 @@ def draw(
     sh_degree = np.broadcast_to(sh_degree, batch_dims)
     visualize_depth = np.broadcast_to(visualize_depth, batch_dims)
 
-    # allocate image
-    images = np.zeros((*batch_dims, height, width, 4), dtype=np.uint8)
+    # allocate image, every pixel is written by the draw
+    if out is None:
+        images = np.empty((*batch_dims, height, width, 4), dtype=np.uint8)
+    else:
+        assert out.shape == (*batch_dims, height, width, 4)
+        assert out.dtype == np.uint8 and out.flags.c_contiguous
+        images = out
 
     # np-style intrinsic to vulkan-style projection
     projections = np.insert(Ks, 2, 0, axis=-1)
@@ -144,29 +248,28 @@ def draw(
     projections[..., 3, 3] = 0
 
     # flatten
-    viewmats = np.ascontiguousarray(viewmats.reshape(-1, 4, 4))
-    projections = np.ascontiguousarray(projections.reshape(-1, 4, 4))
-    backgrounds = np.ascontiguousarray(backgrounds.reshape(-1, 3))
-    eps2d = np.ascontiguousarray(eps2d.reshape(-1))
-    sh_degree = np.ascontiguousarray(sh_degree.reshape(-1))
-    visualize_depth = np.ascontiguousarray(visualize_depth.reshape(-1))
-    images = np.ascontiguousarray(images.reshape(-1, height, width, 4))
-
-    rendered_images = []
-    for i in range(len(images)):
-        rendered_images.append(
-            singleton_renderer.draw(
-                splats,
-                viewmats[i],
-                projections[i],
-                width,
-                height,
-                backgrounds[i],
-                eps2d[i],
-                sh_degree[i],
-                images[i],
-                bool(visualize_depth[i]),
-            )
+    viewmats = np.ascontiguousarray(viewmats.reshape(-1, 4, 4), dtype=np.float32)
+    projections = np.ascontiguousarray(projections.reshape(-1, 4, 4), dtype=np.float32)
+    backgrounds = np.ascontiguousarray(backgrounds.reshape(-1, 3), dtype=np.float32)
+    eps2d = np.ascontiguousarray(eps2d.reshape(-1), dtype=np.float32)
+    sh_degree = np.ascontiguousarray(sh_degree.reshape(-1), dtype=np.int32)
+    visualize_depth = np.ascontiguousarray(visualize_depth.reshape(-1), dtype=bool)
+
+    # all views in one call, recorded and submitted together
+    rendered_images = [
+        singleton_renderer.draw_batch(
+            splats,
+            viewmats,
+            projections,
+            width,
+            height,
+            backgrounds,
+            eps2d,
+            sh_degree,
+            visualize_depth,
+            images.reshape(-1, height, width, 4),
+            sorted_projection,
         )
+    ]
 
     return RenderedImage(images, (*batch_dims, height, width, 4), rendered_images)
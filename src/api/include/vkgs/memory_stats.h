@@ -0,0 +1,38 @@
+#ifndef VKGS_MEMORY_STATS_H
+#define VKGS_MEMORY_STATS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace vkgs {
+
+struct MemoryUsage {
+  uint64_t device = 0;  // bytes in device-local heaps
+  uint64_t host = 0;    // bytes in host heaps
+};
+
+struct SplatsMemory {
+  uint64_t point_count = 0;
+  uint32_t sh_degree = 0;
+  bool resident = false;
+  uint64_t size = 0;  // bytes of device buffers, or of the host copy if evicted
+};
+
+// Memory of a renderer by category, from the sizes of tagged buffers and images and from VMA statistics.
+struct MemoryStats {
+  MemoryUsage splats;          // GaussianSplats buffers, host for evicted copies
+  MemoryUsage sort_scratch;    // per-frame compute scratch of all frame slots: keys, indices, sort storage, instances
+  uint64_t sort_scratch_unaliased = 0;  // device bytes of sort_scratch if its buffers were not aliased by lifetime
+  MemoryUsage images;          // render targets of all frame slots
+  MemoryUsage staging;         // upload staging of loading and the camera upload ring
+  MemoryUsage readback;        // pooled image readback buffers
+  MemoryUsage other;           // untagged buffers and images
+  MemoryUsage pending_retire;  // released buffers and images freed after in-flight tasks, also counted above
+  MemoryUsage allocated;       // all VMA allocations
+  MemoryUsage reserved;        // VMA memory blocks holding the allocations
+  std::vector<SplatsMemory> splats_objects;  // live GaussianSplats
+};
+
+}  // namespace vkgs
+
+#endif  // VKGS_MEMORY_STATS_H
@@ -3,10 +3,14 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "vkgs/export_api.h"
 
 #include "vkgs/draw_options.h"
+#include "vkgs/memory_stats.h"
+#include "vkgs/residency_stats.h"
+#include "vkgs/timing_stats.h"
 
 namespace vkgs {
 namespace core {
@@ -19,19 +23,54 @@ class RenderedImage;
 class VKGS_API Renderer {
  public:
   Renderer();
+  // Draws with images of frames_in_flight draws in flight at once, 2 by default. 1 uses the least memory, 3 or 4 keep
+  // all queues busy for offline batch rendering.
+  explicit Renderer(uint32_t frames_in_flight);
   ~Renderer();
 
+  // Another renderer on the same device with the same frames in flight, sharing draw scratch buffers with this one so
+  // that renderers of differently sized scenes keep one set sized to recent draws. Splats are drawn by the renderer
+  // that created them.
+  Renderer CreateSharingScratch();
+
   const std::string& device_name() const noexcept;
   uint32_t graphics_queue_index() const noexcept;
   uint32_t compute_queue_index() const noexcept;
   uint32_t transfer_queue_index() const noexcept;
 
   GaussianSplats LoadFromPly(const std::string& path, int sh_degree = -1);
+  std::vector<GaussianSplats> LoadManyFromPly(const std::vector<std::string>& paths, int sh_degree = -1);
+  void SaveSplats(GaussianSplats splats, const std::string& path);
+  GaussianSplats LoadSplats(const std::string& path);
+  // Copy permuted into Morton order of positions. Only for splats not yet quantized, interleaved or compressed.
+  GaussianSplats Reorder(GaussianSplats splats);
+  // Copy in compact f16/unorm8 storage, about half the device memory. Cannot be saved with SaveSplats.
+  GaussianSplats Quantize(GaussianSplats splats);
+  // Copy with position and opacity in one vec4 and cov3d as vec4 + vec2, read with aligned vector loads.
+  GaussianSplats Interleave(GaussianSplats splats);
+  // Copy with SH bands above DC replaced by indices into a k-means codebook of codebook_size entries, at most 65536.
+  GaussianSplats CompressSh(GaussianSplats splats, uint32_t codebook_size = 4096);
+  // Arrays are copied before returning, unless owner is given. Then they may be read after returning, and owner, which
+  // must keep them alive, is held until the upload is done.
   GaussianSplats CreateGaussianSplats(size_t size, const float* means, const float* quats, const float* scales,
-                                      const float* opacities, const uint16_t* colors, int sh_degree);
+                                      const float* opacities, const uint16_t* colors, int sh_degree,
+                                      std::shared_ptr<void> owner = nullptr);
   RenderedImage Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst);
+  // Views of the same size into consecutive images of dst, recorded and submitted together. No depth auto-range.
+  RenderedImage DrawBatch(GaussianSplats splats, const std::vector<DrawOptions>& draw_options, uint8_t* dst);
+
+  // Device memory budget of splats in bytes, 0 for the VMA budget. Least recently drawn splats are evicted over budget.
+  void SetMemoryBudget(uint64_t budget);
+  ResidencyStats GetResidencyStats();
+  // Device and host bytes by category with a breakdown per GaussianSplats, and the same as JSON for offline analysis.
+  MemoryStats GetMemoryStats();
+  std::string GetMemoryStatsJson();
+  // GPU time of the rank pass of finished draws, all zero without timestamp support on the compute queue.
+  TimingStats GetTimingStats();
 
  private:
+  explicit Renderer(std::shared_ptr<core::Renderer> renderer);
+
   std::shared_ptr<core::Renderer> renderer_;
 };
 
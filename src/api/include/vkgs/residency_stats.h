@@ -0,0 +1,20 @@
+#ifndef VKGS_RESIDENCY_STATS_H
+#define VKGS_RESIDENCY_STATS_H
+
+#include <cstdint>
+
+namespace vkgs {
+
+struct ResidencyStats {
+  uint64_t hits = 0;       // draws of resident splats
+  uint64_t misses = 0;     // draws that uploaded evicted splats again
+  uint64_t evictions = 0;  // splats evicted to host memory
+  uint64_t resident_count = 0;
+  uint64_t resident_size = 0;  // bytes of device buffers
+  uint64_t evicted_count = 0;
+  uint64_t evicted_size = 0;  // bytes of host copies
+};
+
+}  // namespace vkgs
+
+#endif  // VKGS_RESIDENCY_STATS_H
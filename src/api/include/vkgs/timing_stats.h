@@ -0,0 +1,16 @@
+#ifndef VKGS_TIMING_STATS_H
+#define VKGS_TIMING_STATS_H
+
+#include <cstdint>
+
+namespace vkgs {
+
+struct TimingStats {
+  uint64_t rank_count = 0;      // rank passes, one per Draw and per group of views of DrawBatch
+  uint64_t rank_time = 0;       // nanoseconds of all rank passes
+  uint64_t rank_time_last = 0;  // nanoseconds of the last rank pass
+};
+
+}  // namespace vkgs
+
+#endif  // VKGS_TIMING_STATS_H
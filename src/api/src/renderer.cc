@@ -10,11 +10,41 @@
 #include "vkgs/core/renderer.h"
 
 namespace vkgs {
+namespace {
+
+core::DrawOptions ToCore(const DrawOptions& draw_options) {
+  core::DrawOptions core_draw_options = {};
+  core_draw_options.view = glm::make_mat4(draw_options.view);
+  core_draw_options.projection = glm::make_mat4(draw_options.projection);
+  core_draw_options.width = draw_options.width;
+  core_draw_options.height = draw_options.height;
+  core_draw_options.background = glm::make_vec3(draw_options.background);
+  core_draw_options.eps2d = draw_options.eps2d;
+  core_draw_options.sh_degree = draw_options.sh_degree;
+  core_draw_options.visualize_depth = draw_options.visualize_depth;
+  core_draw_options.depth_auto_range = draw_options.depth_auto_range;
+  core_draw_options.depth_z_min = draw_options.depth_z_min;
+  core_draw_options.depth_z_max = draw_options.depth_z_max;
+  core_draw_options.camera_near = draw_options.camera_near;
+  core_draw_options.camera_far = draw_options.camera_far;
+  core_draw_options.sorted_projection = draw_options.sorted_projection;
+  return core_draw_options;
+}
+
+}  // namespace
 
 Renderer::Renderer() : renderer_(std::make_shared<core::Renderer>()) {}
 
+Renderer::Renderer(uint32_t frames_in_flight) : renderer_(std::make_shared<core::Renderer>(frames_in_flight)) {}
+
+Renderer::Renderer(std::shared_ptr<core::Renderer> renderer) : renderer_(renderer) {}
+
 Renderer::~Renderer() = default;
 
+Renderer Renderer::CreateSharingScratch() {
+  return Renderer(std::make_shared<core::Renderer>(renderer_->scratch_pool(), renderer_->frames_in_flight()));
+}
+
 const std::string& Renderer::device_name() const noexcept { return renderer_->device_name(); }
 uint32_t Renderer::graphics_queue_index() const noexcept { return renderer_->graphics_queue_index(); }
 uint32_t Renderer::compute_queue_index() const noexcept { return renderer_->compute_queue_index(); }
@@ -24,27 +54,94 @@ GaussianSplats Renderer::LoadFromPly(const std::string& path, int sh_degree) {
   return GaussianSplats(renderer_->LoadFromPly(path, sh_degree));
 }
 
+std::vector<GaussianSplats> Renderer::LoadManyFromPly(const std::vector<std::string>& paths, int sh_degree) {
+  std::vector<GaussianSplats> result;
+  for (auto splats : renderer_->LoadManyFromPly(paths, sh_degree)) result.emplace_back(splats);
+  return result;
+}
+
+void Renderer::SaveSplats(GaussianSplats splats, const std::string& path) { renderer_->SaveSplats(splats.get(), path); }
+
+GaussianSplats Renderer::LoadSplats(const std::string& path) { return GaussianSplats(renderer_->LoadSplats(path)); }
+
+GaussianSplats Renderer::Reorder(GaussianSplats splats) { return GaussianSplats(renderer_->Reorder(splats.get())); }
+
+GaussianSplats Renderer::Quantize(GaussianSplats splats) { return GaussianSplats(renderer_->Quantize(splats.get())); }
+
+GaussianSplats Renderer::Interleave(GaussianSplats splats) {
+  return GaussianSplats(renderer_->Interleave(splats.get()));
+}
+
+GaussianSplats Renderer::CompressSh(GaussianSplats splats, uint32_t codebook_size) {
+  return GaussianSplats(renderer_->CompressSh(splats.get(), codebook_size));
+}
+
 GaussianSplats Renderer::CreateGaussianSplats(size_t size, const float* means, const float* quats, const float* scales,
-                                              const float* opacities, const uint16_t* colors, int sh_degree) {
-  return GaussianSplats(renderer_->CreateGaussianSplats(size, means, quats, scales, opacities, colors, sh_degree));
+                                              const float* opacities, const uint16_t* colors, int sh_degree,
+                                              std::shared_ptr<void> owner) {
+  return GaussianSplats(
+      renderer_->CreateGaussianSplats(size, means, quats, scales, opacities, colors, sh_degree, std::move(owner)));
 }
 
 RenderedImage Renderer::Draw(GaussianSplats splats, const DrawOptions& draw_options, uint8_t* dst) {
-  core::DrawOptions core_draw_options = {};
-  core_draw_options.view = glm::make_mat4(draw_options.view);
-  core_draw_options.projection = glm::make_mat4(draw_options.projection);
-  core_draw_options.width = draw_options.width;
-  core_draw_options.height = draw_options.height;
-  core_draw_options.background = glm::make_vec3(draw_options.background);
-  core_draw_options.eps2d = draw_options.eps2d;
-  core_draw_options.sh_degree = draw_options.sh_degree;
-  core_draw_options.visualize_depth = draw_options.visualize_depth;
-  core_draw_options.depth_auto_range = draw_options.depth_auto_range;
-  core_draw_options.depth_z_min = draw_options.depth_z_min;
-  core_draw_options.depth_z_max = draw_options.depth_z_max;
-  core_draw_options.camera_near = draw_options.camera_near;
-  core_draw_options.camera_far = draw_options.camera_far;
-  return RenderedImage(renderer_->Draw(splats.get(), core_draw_options, dst));
+  return RenderedImage(renderer_->Draw(splats.get(), ToCore(draw_options), dst));
+}
+
+RenderedImage Renderer::DrawBatch(GaussianSplats splats, const std::vector<DrawOptions>& draw_options, uint8_t* dst) {
+  std::vector<core::DrawOptions> core_draw_options;
+  for (const auto& options : draw_options) core_draw_options.push_back(ToCore(options));
+  return RenderedImage(renderer_->DrawBatch(splats.get(), core_draw_options, dst));
+}
+
+void Renderer::SetMemoryBudget(uint64_t budget) { renderer_->SetMemoryBudget(budget); }
+
+ResidencyStats Renderer::GetResidencyStats() {
+  auto core_stats = renderer_->GetResidencyStats();
+  ResidencyStats stats;
+  stats.hits = core_stats.hits;
+  stats.misses = core_stats.misses;
+  stats.evictions = core_stats.evictions;
+  stats.resident_count = core_stats.resident_count;
+  stats.resident_size = core_stats.resident_size;
+  stats.evicted_count = core_stats.evicted_count;
+  stats.evicted_size = core_stats.evicted_size;
+  return stats;
+}
+
+MemoryStats Renderer::GetMemoryStats() {
+  auto core_stats = renderer_->GetMemoryStats();
+  auto usage = [](const core::MemoryUsage& core_usage) { return MemoryUsage{core_usage.device, core_usage.host}; };
+  MemoryStats stats;
+  stats.splats = usage(core_stats.splats);
+  stats.sort_scratch = usage(core_stats.sort_scratch);
+  stats.sort_scratch_unaliased = core_stats.sort_scratch_unaliased;
+  stats.images = usage(core_stats.images);
+  stats.staging = usage(core_stats.staging);
+  stats.readback = usage(core_stats.readback);
+  stats.other = usage(core_stats.other);
+  stats.pending_retire = usage(core_stats.pending_retire);
+  stats.allocated = usage(core_stats.allocated);
+  stats.reserved = usage(core_stats.reserved);
+  for (const auto& core_splats : core_stats.splats_objects) {
+    SplatsMemory splats;
+    splats.point_count = core_splats.point_count;
+    splats.sh_degree = core_splats.sh_degree;
+    splats.resident = core_splats.resident;
+    splats.size = core_splats.size;
+    stats.splats_objects.push_back(splats);
+  }
+  return stats;
+}
+
+std::string Renderer::GetMemoryStatsJson() { return renderer_->GetMemoryStatsJson(); }
+
+TimingStats Renderer::GetTimingStats() {
+  auto core_stats = renderer_->GetTimingStats();
+  TimingStats stats;
+  stats.rank_count = core_stats.rank_count;
+  stats.rank_time = core_stats.rank_time;
+  stats.rank_time_last = core_stats.rank_time_last;
+  return stats;
 }
 
 }  // namespace vkgs
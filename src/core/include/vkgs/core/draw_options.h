@@ -20,6 +20,9 @@ struct DrawOptions {
   float depth_z_max = 50.0f;
   float camera_near = 0.1f;
   float camera_far = 1000.0f;
+  // Projects visible splats in sorted order, skipping the inverse index pass. Work is proportional to the visible
+  // count rather than to the point count, for views seeing a small part of a large scene.
+  bool sorted_projection = true;
   // Output parameters for auto-range (filled in by Draw when depth_auto_range is true)
   float* depth_z_min_out = nullptr;
   float* depth_z_max_out = nullptr;
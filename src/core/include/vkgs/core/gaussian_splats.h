@@ -1,7 +1,9 @@
 #ifndef VKGS_CORE_GAUSSIAN_SPLATS_H
 #define VKGS_CORE_GAUSSIAN_SPLATS_H
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "export_api.h"
 
@@ -15,12 +17,16 @@ class Task;
 
 namespace core {
 
+class Renderer;
+
 class VKGS_CORE_API GaussianSplats {
+  friend class Renderer;
+
  public:
   GaussianSplats(size_t size, uint32_t sh_degree, std::shared_ptr<gpu::Buffer> position,
                  std::shared_ptr<gpu::Buffer> cov3d, std::shared_ptr<gpu::Buffer> sh,
-                 std::shared_ptr<gpu::Buffer> opacity, std::shared_ptr<gpu::Buffer> index,
-                 std::shared_ptr<gpu::Task> task);
+                 std::shared_ptr<gpu::Buffer> opacity, std::shared_ptr<gpu::Task> task,
+                 std::shared_ptr<gpu::Buffer> chunk = nullptr, std::shared_ptr<gpu::Buffer> sh_codebook = nullptr);
 
   ~GaussianSplats();
 
@@ -30,19 +36,57 @@ class VKGS_CORE_API GaussianSplats {
   auto cov3d() const noexcept { return cov3d_; }
   auto sh() const noexcept { return sh_; }
   auto opacity() const noexcept { return opacity_; }
-  auto index_buffer() const noexcept { return index_buffer_; }
+  auto chunk() const noexcept { return chunk_; }
+  auto sh_codebook() const noexcept { return sh_codebook_; }
+
+  // Compact storage created by Renderer::Quantize. Positions are f16 offsets from chunk centers, cov3d is f16 scaled
+  // by a chunk factor and opacity is unorm8.
+  bool quantized() const noexcept { return quantized_; }
+
+  // Vector-aligned storage created by Renderer::Interleave, without a separate opacity buffer. position holds a vec4
+  // of position and opacity per point, and cov3d holds a vec4 of the first four values per point followed by the last
+  // two values of each point, two points per vec4.
+  bool interleaved() const noexcept { return interleaved_; }
+
+  // SH storage created by Renderer::CompressSh. sh holds the DC and a codebook index per splat, and the codebook holds
+  // the higher bands.
+  bool has_sh_codebook() const noexcept { return has_sh_codebook_; }
+
+  // Device buffers [position, cov3d, sh, opacity unless interleaved, chunk if quantized, sh_codebook if any], empty if
+  // not resident.
+  std::vector<std::shared_ptr<gpu::Buffer>> buffers() const;
+
+  // False if the device buffers have been evicted to host memory by the renderer. They are uploaded again on the next
+  // Draw.
+  bool resident() const noexcept { return position_ != nullptr; }
+  // Byte size of the device buffers, whether resident or not.
+  uint64_t device_size() const noexcept { return device_size_; }
+  // Device buffers packed in host memory while evicted, null if resident. The copy into it may still be in flight.
+  auto host() const noexcept { return host_; }
 
   void Wait();
 
  private:
+  void Evict(std::shared_ptr<gpu::Buffer> host);
+  // Buffers in the order of buffers(), with buffer_sizes().
+  void Restore(const std::vector<std::shared_ptr<gpu::Buffer>>& buffers);
+  const std::vector<uint64_t>& buffer_sizes() const noexcept { return buffer_sizes_; }
+
   size_t size_;
   uint32_t sh_degree_;
-  std::shared_ptr<gpu::Buffer> position_;      // (N, 3)
-  std::shared_ptr<gpu::Buffer> cov3d_;         // (N, 6)
-  std::shared_ptr<gpu::Buffer> sh_;            // (N, K) float16
-  std::shared_ptr<gpu::Buffer> opacity_;       // (N)
-  std::shared_ptr<gpu::Buffer> index_buffer_;  // (N, 6)
+  bool quantized_;
+  bool interleaved_;
+  bool has_sh_codebook_;
+  std::shared_ptr<gpu::Buffer> position_;     // (N, 3), float or float16 if quantized, (N, 4) if interleaved
+  std::shared_ptr<gpu::Buffer> cov3d_;        // (N, 6), float or float16 if quantized, (N * 1.5, 4) if interleaved
+  std::shared_ptr<gpu::Buffer> sh_;           // (N, K) float16, or (N, 2) DC and codebook index
+  std::shared_ptr<gpu::Buffer> opacity_;      // (N), float or unorm8 if quantized, null if interleaved
+  std::shared_ptr<gpu::Buffer> chunk_;        // (N / 256, 4), center and cov3d scale if quantized
+  std::shared_ptr<gpu::Buffer> sh_codebook_;  // (C, K) float16 with zero DC
   std::shared_ptr<gpu::Task> task_;
+  std::vector<uint64_t> buffer_sizes_;
+  uint64_t device_size_ = 0;
+  std::shared_ptr<gpu::Buffer> host_;  // Buffers packed in host memory while evicted
 };
 
 }  // namespace core
@@ -0,0 +1,20 @@
+#ifndef VKGS_CORE_LOAD_OPTIONS_H
+#define VKGS_CORE_LOAD_OPTIONS_H
+
+#include <cstdint>
+
+namespace vkgs {
+namespace core {
+
+struct LoadOptions {
+  int sh_degree = -1;             // -1 for the maximum degree of the data
+  bool reorder = false;           // Renderer::Reorder after loading
+  bool interleave = false;        // Renderer::Interleave after loading
+  bool quantize = false;          // Renderer::Quantize after loading
+  uint32_t sh_codebook_size = 0;  // Renderer::CompressSh after loading if not 0
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_LOAD_OPTIONS_H
@@ -0,0 +1,84 @@
+#ifndef VKGS_CORE_LOAD_TASK_H
+#define VKGS_CORE_LOAD_TASK_H
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <glm/glm.hpp>
+
+#include "export_api.h"
+
+namespace vkgs {
+namespace core {
+
+class GaussianSplats;
+class Renderer;
+
+// Handle of a load running on a worker thread, created by Renderer::LoadFromPlyAsync.
+// Progress counters may be read from any thread. The returned GaussianSplats still carries the gpu::Task that gates
+// GPU readiness, so drawing right after Get() is safe.
+class VKGS_CORE_API LoadTask {
+ public:
+  LoadTask();
+  ~LoadTask();  // cancels and joins the worker
+
+  LoadTask(const LoadTask&) = delete;
+  LoadTask& operator=(const LoadTask&) = delete;
+
+  uint64_t bytes_read() const noexcept { return bytes_read_; }
+  uint64_t bytes_total() const noexcept { return bytes_total_; }
+  // Points submitted to the GPU for parsing.
+  uint64_t points_parsed() const noexcept { return points_parsed_; }
+  uint64_t point_count() const noexcept { return point_count_; }
+  // Fraction of points parsed, in [0, 1].
+  float progress() const noexcept;
+
+  // Bounds of the loaded splat positions, gathered while the file streams. Valid once IsDone() if has_bounds().
+  bool has_bounds() const noexcept { return has_bounds_; }
+  glm::vec3 bounds_min() const noexcept { return bounds_min_; }
+  glm::vec3 bounds_max() const noexcept { return bounds_max_; }
+
+  bool IsDone() const noexcept { return done_; }
+  bool cancelled() const noexcept { return cancelled_; }
+
+  // Requests cancellation. The load stops at the next chunk boundary and Get() throws.
+  void Cancel() noexcept { cancelled_ = true; }
+
+  void Wait();
+
+  // Waits for the worker and returns the splats, rethrowing any error of the load.
+  std::shared_ptr<GaussianSplats> Get();
+
+ private:
+  friend class Renderer;
+
+  void Start(std::function<std::shared_ptr<GaussianSplats>(LoadTask*)> load);
+  void SetTotal(uint64_t bytes_total, uint64_t point_count) noexcept;
+  void AddProgress(uint64_t bytes_read, uint64_t points_parsed) noexcept;
+  void SetBounds(const glm::vec3& min, const glm::vec3& max) noexcept;
+
+  std::atomic<uint64_t> bytes_read_ = 0;
+  std::atomic<uint64_t> bytes_total_ = 0;
+  std::atomic<uint64_t> points_parsed_ = 0;
+  std::atomic<uint64_t> point_count_ = 0;
+  std::atomic<bool> cancelled_ = false;
+  std::atomic<bool> done_ = false;
+
+  // Written by the worker before done_ is set.
+  bool has_bounds_ = false;
+  glm::vec3 bounds_min_ = glm::vec3(0.f);
+  glm::vec3 bounds_max_ = glm::vec3(0.f);
+
+  std::thread thread_;
+  std::shared_ptr<GaussianSplats> splats_;
+  std::exception_ptr exception_;
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_LOAD_TASK_H
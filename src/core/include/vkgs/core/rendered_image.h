@@ -18,6 +18,8 @@ namespace core {
 class VKGS_CORE_API RenderedImage {
  public:
   RenderedImage(uint32_t width, uint32_t height, std::shared_ptr<gpu::Task> task);
+  // Images of a batch, ready once all tasks are done.
+  RenderedImage(uint32_t width, uint32_t height, std::vector<std::shared_ptr<gpu::Task>> tasks);
   ~RenderedImage();
 
   uint32_t width() const noexcept { return width_; }
@@ -28,7 +30,7 @@ class VKGS_CORE_API RenderedImage {
  private:
   uint32_t width_;
   uint32_t height_;
-  std::shared_ptr<gpu::Task> task_;
+  std::vector<std::shared_ptr<gpu::Task>> tasks_;
 };
 
 }  // namespace core
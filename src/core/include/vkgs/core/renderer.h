@@ -1,26 +1,36 @@
 #ifndef VKGS_CORE_RENDERER_H
 #define VKGS_CORE_RENDERER_H
 
-#include <array>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <glm/glm.hpp>
 
 #include "export_api.h"
 
 #include "vkgs/core/draw_options.h"
+#include "vkgs/core/load_options.h"
+#include "vkgs/core/memory_stats.h"
+#include "vkgs/core/residency_stats.h"
+#include "vkgs/core/timing_stats.h"
 
 namespace vkgs {
 namespace gpu {
 
 class Device;
+class Buffer;
 class TaskMonitor;
 class PipelineLayout;
 class ComputePipeline;
 class GraphicsPipeline;
 class Semaphore;
+class Task;
+class Command;
+class QueryPool;
 
 }  // namespace gpu
 
@@ -32,10 +42,25 @@ class Sorter;
 class ComputeStorage;
 class GraphicsStorage;
 class TransferStorage;
+class LoadTask;
+class ResidencyManager;
+class UploadRing;
+class HostBufferPool;
+class ScratchPool;
+class GpuTimer;
+class MappedFile;
+struct PlyHeader;
 
 class VKGS_CORE_API Renderer {
  public:
   Renderer();
+  // frames_in_flight is the number of draws whose images are in flight at once, each with images and semaphores of its
+  // own. 1 uses the least memory; 3 or 4 keep the compute, graphics and transfer queues busy on large GPUs.
+  explicit Renderer(uint32_t frames_in_flight);
+  // Renderer on the device of scratch_pool, drawing with compute scratch shared with the other renderers of the pool,
+  // so that mixed-size workloads across renderers keep one set of scratch buffers. Queue submission is guarded by
+  // one mutex across the renderers of the pool.
+  explicit Renderer(std::shared_ptr<ScratchPool> scratch_pool, uint32_t frames_in_flight = 2);
   ~Renderer();
 
   const std::string& device_name() const noexcept;
@@ -45,42 +70,183 @@ class VKGS_CORE_API Renderer {
 
   // For viewer integration
   std::shared_ptr<gpu::Device> device() const noexcept { return device_; }
+  // Guards queue submission. Hold it while submitting to device queues from other threads, e.g. during
+  // LoadFromPlyAsync.
+  std::mutex& mutex() noexcept { return *mutex_; }
+  // Compute scratch of draws, to create other renderers sharing it with Renderer(scratch_pool()).
+  std::shared_ptr<ScratchPool> scratch_pool() const noexcept { return scratch_pool_; }
+  uint32_t frames_in_flight() const noexcept { return frames_.size(); }
 
+  // Arrays are copied before returning, unless owner is given. Then the device may import them and read them after
+  // returning, and owner, which must keep them alive, is held until the upload is done.
   std::shared_ptr<GaussianSplats> CreateGaussianSplats(size_t size, const float* means, const float* quats,
                                                        const float* scales, const float* opacities,
-                                                       const uint16_t* colors, int sh_degree);
+                                                       const uint16_t* colors, int sh_degree,
+                                                       std::shared_ptr<void> owner = nullptr);
   std::shared_ptr<GaussianSplats> LoadFromPly(const std::string& path, int sh_degree = -1);
+  // Returns immediately, loading on a worker thread. The renderer must outlive the task.
+  std::shared_ptr<LoadTask> LoadFromPlyAsync(const std::string& path, const LoadOptions& options = {});
+  // Loads many files at once, one GaussianSplats per path. Files are read in parallel and their uploads share staging
+  // chunks, so the number of queue submissions depends on the total size, not on the number of files.
+  std::vector<std::shared_ptr<GaussianSplats>> LoadManyFromPly(const std::vector<std::string>& paths,
+                                                               int sh_degree = -1);
+
+  // Pre-parsed splat file (.vkgs) with the GPU layout of GaussianSplats, loaded without a parsing pass.
+  void SaveSplats(std::shared_ptr<GaussianSplats> splats, const std::string& path);
+  std::shared_ptr<GaussianSplats> LoadSplats(const std::string& path);
+
+  // Returns a copy of splats permuted into Morton order of their positions, 10 bits per axis within the bounds of all
+  // points, so that points close in space are close in memory. Only splats in the default layout can be reordered, so
+  // reorder before Quantize, Interleave or CompressSh.
+  std::shared_ptr<GaussianSplats> Reorder(std::shared_ptr<GaussianSplats> splats);
+  // Returns a copy of splats in compact storage: positions as f16 offsets from the center of each chunk of 256 points,
+  // cov3d as f16 with a scale per chunk and opacity as unorm8, about half the memory and bandwidth. Drawn with
+  // decoding variants of the compute pipelines. Quantized splats cannot be saved with SaveSplats.
+  std::shared_ptr<GaussianSplats> Quantize(std::shared_ptr<GaussianSplats> splats);
+  // Returns a copy of splats in a layout read with aligned vector loads: a vec4 of position and opacity per point, and
+  // cov3d as a vec4 per point followed by the two remaining values of each point. Cannot be combined with Quantize.
+  std::shared_ptr<GaussianSplats> Interleave(std::shared_ptr<GaussianSplats> splats);
+  // Returns a copy of splats whose SH bands above DC are replaced by an index into a k-means codebook of codebook_size
+  // entries, at most 65536, shared by all points. DC stays per point. The codebook is trained on a sample of the
+  // points, with assignment on the GPU and updates on CPU threads. Splats without higher bands are returned as is.
+  std::shared_ptr<GaussianSplats> CompressSh(std::shared_ptr<GaussianSplats> splats, uint32_t codebook_size = 4096);
   std::shared_ptr<RenderedImage> Draw(std::shared_ptr<GaussianSplats> splats, const DrawOptions& draw_options,
                                       uint8_t* dst);
+  // Draws views of the same size into consecutive images of dst. Groups of views are ranked and sorted together by
+  // (view, depth) keys as their compute scratch fits, with one submission per queue for each group. Depth auto-range is
+  // not supported.
+  std::shared_ptr<RenderedImage> DrawBatch(std::shared_ptr<GaussianSplats> splats,
+                                           const std::vector<DrawOptions>& draw_options, uint8_t* dst);
+
+  // Budget in bytes for the device buffers of all GaussianSplats. When over budget, the least recently drawn splats are
+  // evicted to host memory and uploaded again on their next Draw. 0, the default, uses the budget of device-local
+  // heaps reported by VMA.
+  void SetMemoryBudget(uint64_t budget);
+  ResidencyStats GetResidencyStats();
+
+  // Device and host memory by category, with a breakdown per GaussianSplats, and the same as a JSON object.
+  MemoryStats GetMemoryStats();
+  std::string GetMemoryStatsJson();
+
+  // GPU time of the rank pass of draws done so far.
+  TimingStats GetTimingStats();
 
  private:
+  // A piece of parse input written to staging memory at offset, covering points [point_offset, point_offset +
+  // point_count) of target.
+  struct ParseChunk {
+    uint32_t point_offset;
+    uint32_t point_count;
+    uint64_t size;       // bytes to upload
+    uint64_t read_size;  // bytes of the file consumed, for progress
+    uint32_t target = 0;
+    uint64_t offset = 0;  // byte offset in the staging chunk, aligned for storage buffer descriptors
+  };
+
+  // Output splats of ParseChunked, parsed with pipeline.
+  struct ParseTarget {
+    uint32_t point_count;
+    uint32_t sh_degree;
+    uint32_t sh_packed_size;
+    std::shared_ptr<gpu::ComputePipeline> pipeline;
+  };
+
+  // Reports progress to and checks cancellation of task, if not null.
+  std::shared_ptr<GaussianSplats> LoadFromPly(const std::string& path, int sh_degree, LoadTask* task);
+
+  std::shared_ptr<GaussianSplats> LoadFromCompressedPly(MappedFile& file, const PlyHeader& header,
+                                                        const std::string& path, int sh_degree, LoadTask* task);
+
+  // Streams chunk_count chunks filled by fill(chunk, staging memory) to the GPU and parses each into new splat
+  // buffers with pipeline, using the parse pipeline layout.
+  std::shared_ptr<GaussianSplats> ParseChunked(uint32_t point_count, uint32_t sh_degree, uint32_t sh_packed_size,
+                                               uint32_t chunk_count, uint64_t chunk_buffer_size,
+                                               std::shared_ptr<gpu::ComputePipeline> pipeline,
+                                               const std::function<ParseChunk(uint32_t, char*)>& fill,
+                                               LoadTask* task);
+
+  // Same as above for many targets, where fill returns the pieces written to each chunk.
+  std::vector<std::shared_ptr<GaussianSplats>> ParseChunked(
+      const std::vector<ParseTarget>& targets, uint32_t chunk_count, uint64_t chunk_buffer_size,
+      const std::function<std::vector<ParseChunk>(uint32_t, char*)>& fill, LoadTask* task);
+
+  // Residency, all of which require mutex_ to be held except Track.
+  // Starts tracking newly created splats, evicting others if over budget.
+  std::shared_ptr<GaussianSplats> Track(std::shared_ptr<GaussianSplats> splats);
+  // Uploads evicted splats again and marks them as used. Returns true if they were evicted.
+  bool MakeResident(std::shared_ptr<GaussianSplats> splats);
+  void Evict(std::shared_ptr<GaussianSplats> splats);
+  // Evicts least recently used splats other than exclude until required more bytes fit in the budget.
+  void EnforceBudget(uint64_t required, const GaussianSplats* exclude);
+  // Copies the device buffers of splats from or to host at offsets on the compute queue.
+  std::shared_ptr<gpu::Task> CopySplatSections(std::shared_ptr<GaussianSplats> splats,
+                                               std::shared_ptr<gpu::Buffer> host,
+                                               const std::vector<uint64_t>& offsets, bool download);
+
+  // Recording shared by Draw and DrawBatch: rank, sort and projection of splats into compute_storage for view_count
+  // views sharing eps2d and sh_degree, and the splat draw of one of the views from compute_storage into the images of
+  // graphics_storage, left as color and depth attachments. Queries 0 and 1 of rank_queries, unless null, are written
+  // before and after the rank pass.
+  void RecordProjection(gpu::Command& cb, std::shared_ptr<GaussianSplats> splats, const DrawOptions* draw_options,
+                        uint32_t view_count, const ComputeStorage& compute_storage, gpu::QueryPool* rank_queries);
+  void RecordSplats(gpu::Command& cb, const DrawOptions& draw_options, const GraphicsStorage& graphics_storage,
+                    const ComputeStorage& compute_storage, uint32_t view);
+  // Inverse of sorted index of instance_count instances for projection in point order, after the sort.
+  void RecordInverseIndex(gpu::Command& cb, uint32_t instance_count, const ComputeStorage& compute_storage);
+
+  std::shared_ptr<std::mutex> mutex_;  // shared by renderers of the same scratch pool, which share queues
   std::shared_ptr<gpu::Device> device_;
   std::shared_ptr<gpu::TaskMonitor> task_monitor_;
+  std::shared_ptr<ResidencyManager> residency_manager_;
+  uint64_t memory_budget_ = 0;
   std::shared_ptr<Sorter> sorter_;
+  // Per-draw camera uploads, image readbacks and CreateGaussianSplats staging, recycled by fence so that steady-state
+  // draws and uploads allocate nothing.
+  std::shared_ptr<UploadRing> upload_ring_;
+  std::shared_ptr<HostBufferPool> readback_pool_;
+  std::shared_ptr<HostBufferPool> staging_pool_;
+  std::shared_ptr<ScratchPool> scratch_pool_;
+  std::shared_ptr<GpuTimer> gpu_timer_;
 
   std::shared_ptr<gpu::PipelineLayout> parse_pipeline_layout_;
   std::shared_ptr<gpu::ComputePipeline> parse_ply_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> parse_compressed_ply_pipeline_;
   std::shared_ptr<gpu::ComputePipeline> parse_data_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> quantize_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> sh_codebook_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> interleave_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> morton_bounds_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> morton_pipeline_;
 
   std::shared_ptr<gpu::PipelineLayout> compute_pipeline_layout_;
   std::shared_ptr<gpu::ComputePipeline> rank_pipeline_;
   std::shared_ptr<gpu::ComputePipeline> inverse_index_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> dispatch_indirect_pipeline_;
   std::shared_ptr<gpu::ComputePipeline> projection_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> rank_quantized_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> projection_quantized_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> projection_sh_codebook_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> projection_quantized_sh_codebook_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> rank_interleaved_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> projection_interleaved_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> projection_interleaved_sh_codebook_pipeline_;
+  std::shared_ptr<gpu::ComputePipeline> reorder_pipeline_;
 
   std::shared_ptr<gpu::PipelineLayout> graphics_pipeline_layout_;
   std::shared_ptr<gpu::GraphicsPipeline> splat_pipeline_;
   std::shared_ptr<gpu::GraphicsPipeline> splat_pipeline_depth_write_;  // Pipeline with depth writing enabled (for auto-range)
   std::shared_ptr<gpu::GraphicsPipeline> splat_background_pipeline_;
 
-  struct DoubleBuffer {
-    std::shared_ptr<ComputeStorage> compute_storage;
+  // Storages and timelines of a frame in flight, used by every frames_in_flight()-th draw. Waits on the semaphores of
+  // a frame are on its previous draw.
+  struct Frame {
     std::shared_ptr<GraphicsStorage> graphics_storage;
     std::shared_ptr<TransferStorage> transfer_storage;
     std::shared_ptr<gpu::Semaphore> compute_semaphore;
     std::shared_ptr<gpu::Semaphore> graphics_semaphore;
     std::shared_ptr<gpu::Semaphore> transfer_semaphore;
   };
-  std::array<DoubleBuffer, 2> double_buffer_;
+  std::vector<Frame> frames_;
 
   uint64_t frame_index_ = 0;
 };
@@ -0,0 +1,22 @@
+#ifndef VKGS_CORE_RESIDENCY_STATS_H
+#define VKGS_CORE_RESIDENCY_STATS_H
+
+#include <cstdint>
+
+namespace vkgs {
+namespace core {
+
+struct ResidencyStats {
+  uint64_t hits = 0;       // draws of resident splats
+  uint64_t misses = 0;     // draws that uploaded evicted splats again
+  uint64_t evictions = 0;  // splats evicted to host memory
+  uint64_t resident_count = 0;
+  uint64_t resident_size = 0;  // bytes of device buffers
+  uint64_t evicted_count = 0;
+  uint64_t evicted_size = 0;  // bytes of host copies
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_RESIDENCY_STATS_H
@@ -0,0 +1,20 @@
+#ifndef VKGS_CORE_TIMING_STATS_H
+#define VKGS_CORE_TIMING_STATS_H
+
+#include <cstdint>
+
+namespace vkgs {
+namespace core {
+
+// GPU time of compute passes from timestamp queries, counted once their draws are done. All zero if the compute queue
+// has no timestamps.
+struct TimingStats {
+  uint64_t rank_count = 0;      // rank passes, one per Draw and per group of views of DrawBatch
+  uint64_t rank_time = 0;       // nanoseconds of all rank passes
+  uint64_t rank_time_last = 0;  // nanoseconds of the last rank pass
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_TIMING_STATS_H
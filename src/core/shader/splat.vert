@@ -1,21 +1,25 @@
 #version 460 core
 
 layout(std430, binding = 0) readonly buffer Instances {
-  vec4 instances[];  // (N, 12). 3 for ndc position, 1 padding, 4 for rot scale, 4 for color.
+  // (N, 3), 24 bytes per splat: ndc xy as f32 bits, ndc z as f32 bits and rgba as unorm8, rot scale columns as f16.
+  uvec2 instances[];
 };
 
 layout(location = 0) out vec4 out_color;
 layout(location = 1) out vec2 out_position;
 
 void main() {
-  // index [0,1,2,2,1,3], 4 vertices for a splat.
-  int index = gl_VertexIndex / 4;
-  vec3 ndc_position = instances[index * 3 + 0].xyz;
-  mat2 rot_scale = mat2(instances[index * 3 + 1].xy, instances[index * 3 + 1].zw);
-  vec4 color = instances[index * 3 + 2];
+  // One instance per splat, triangle strip of 4 vertices [0,1,2,3].
+  uint index = gl_InstanceIndex;
+  uvec2 instance0 = instances[index * 3 + 0];
+  uvec2 instance1 = instances[index * 3 + 1];
+  uvec2 instance2 = instances[index * 3 + 2];
+  vec3 ndc_position = vec3(uintBitsToFloat(instance0), uintBitsToFloat(instance1.x));
+  vec4 color = unpackUnorm4x8(instance1.y);
+  mat2 rot_scale = mat2(unpackHalf2x16(instance2.x), unpackHalf2x16(instance2.y));
 
   // quad positions (-1, -1), (-1, 1), (1, -1), (1, 1), ccw in screen space.
-  int vert_index = gl_VertexIndex % 4;
+  int vert_index = gl_VertexIndex;
   vec2 position = vec2(vert_index / 2, vert_index % 2) * 2.f - 1.f;
 
   float confidence_radius = 3.33f;
@@ -1,36 +1,74 @@
 #include "compute_storage.h"
 
+#include <algorithm>
+
 #include "vkgs/gpu/buffer.h"
 
+#include "memory_tag.h"
 #include "struct.h"
 
 namespace vkgs {
 namespace core {
+namespace {
+
+// Offset alignment of aliased buffers, at least the memory alignment of storage buffers on all devices.
+uint64_t Align(uint64_t size) { return (size + 255) / 256 * 256; }
+
+}  // namespace
 
 ComputeStorage::ComputeStorage(std::shared_ptr<gpu::Device> device) : device_(device) {
   visible_point_count_ = gpu::Buffer::Create(
       device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-      sizeof(uint32_t));
+      (1 + kMaxViewCount) * sizeof(uint32_t));
   camera_ = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                                sizeof(Camera));
+                                kMaxViewCount * sizeof(Camera));
   draw_indirect_ =
       gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
-                          sizeof(VkDrawIndexedIndirectCommand));
+                          kMaxViewCount * sizeof(VkDrawIndirectCommand));
+  dispatch_indirect_ =
+      gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                          sizeof(VkDispatchIndirectCommand));
 }
 
 ComputeStorage::~ComputeStorage() {}
 
-void ComputeStorage::Update(uint32_t point_count, const VrdxSorterStorageRequirements& storage_requirements) {
-  // Get new stage buffers
-  camera_stage_ = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, sizeof(Camera), true);
+uint64_t ComputeStorage::ScratchSize(uint32_t point_count,
+                                     const VrdxSorterStorageRequirements& storage_requirements) {
+  uint64_t index_size = static_cast<uint64_t>(point_count) * sizeof(uint32_t);
+  uint64_t instances_size = static_cast<uint64_t>(point_count) * 6 * sizeof(uint32_t);
+  return 2 * Align(index_size) + std::max(storage_requirements.size, instances_size);
+}
 
+void ComputeStorage::Update(uint32_t point_count, const VrdxSorterStorageRequirements& storage_requirements) {
   if (point_count_ < point_count) {
-    key_ = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * sizeof(uint32_t));
-    index_ = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * sizeof(uint32_t));
-    sort_storage_ = gpu::Buffer::Create(device_, storage_requirements.usage, storage_requirements.size);
-    inverse_index_ = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                                         point_count * sizeof(uint32_t));
-    instances_ = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * 12 * sizeof(float));
+    // Ranges: [key | inverse_index], [index], [sort_storage | instances].
+    uint64_t index_size = static_cast<uint64_t>(point_count) * sizeof(uint32_t);
+    uint64_t instances_size = static_cast<uint64_t>(point_count) * 6 * sizeof(uint32_t);
+    uint64_t index_offset = Align(index_size);
+    uint64_t storage_offset = index_offset + Align(index_size);
+    scratch_size_ = ScratchSize(point_count, storage_requirements);
+    unaliased_scratch_size_ = 3 * index_size + storage_requirements.size + instances_size;
+
+    // Release the previous allocation before making a larger one.
+    key_.reset();
+    index_.reset();
+    sort_storage_.reset();
+    inverse_index_.reset();
+    instances_.reset();
+    scratch_.reset();
+    scratch_ = gpu::Buffer::Create(device_,
+                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                       storage_requirements.usage,
+                                   scratch_size_);
+    scratch_->set_tag(kMemoryTagSortScratch);
+    key_ = gpu::Buffer::CreateAliased(scratch_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 0, index_size);
+    inverse_index_ = gpu::Buffer::CreateAliased(
+        scratch_, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 0, index_size);
+    index_ = gpu::Buffer::CreateAliased(scratch_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, index_offset, index_size);
+    sort_storage_ = gpu::Buffer::CreateAliased(scratch_, storage_requirements.usage, storage_offset,
+                                               storage_requirements.size);
+    instances_ =
+        gpu::Buffer::CreateAliased(scratch_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, storage_offset, instances_size);
 
     point_count_ = point_count;
   }
@@ -16,6 +16,9 @@ class Buffer;
 
 namespace core {
 
+// Views projected and sorted together by one storage, the view index taking the top bits of sort keys.
+constexpr uint32_t kMaxViewCount = 16;
+
 class ComputeStorage {
  public:
   ComputeStorage(std::shared_ptr<gpu::Device> device);
@@ -24,31 +27,44 @@ class ComputeStorage {
   auto visible_point_count() const noexcept { return visible_point_count_; }
   auto camera() const noexcept { return camera_; }
   auto draw_indirect() const noexcept { return draw_indirect_; }
-  auto camera_stage() const noexcept { return camera_stage_; }
+  auto dispatch_indirect() const noexcept { return dispatch_indirect_; }
   auto key() const noexcept { return key_; }
   auto index() const noexcept { return index_; }
   auto sort_storage() const noexcept { return sort_storage_; }
   auto inverse_index() const noexcept { return inverse_index_; }
   auto instances() const noexcept { return instances_; }
+  // Number of points the variable buffers hold.
+  auto capacity() const noexcept { return point_count_; }
+  // Bytes of the per-frame scratch allocation, and of the same buffers without aliasing.
+  auto scratch_size() const noexcept { return scratch_size_; }
+  auto unaliased_scratch_size() const noexcept { return unaliased_scratch_size_; }
 
   void Update(uint32_t point_count, const VrdxSorterStorageRequirements& storage_requirements);
 
+  // Bytes of scratch_size() after Update with the arguments.
+  static uint64_t ScratchSize(uint32_t point_count, const VrdxSorterStorageRequirements& storage_requirements);
+
  private:
   std::shared_ptr<gpu::Device> device_;
   uint32_t point_count_ = 0;
 
   // Fixed
-  std::shared_ptr<gpu::Buffer> visible_point_count_;  // (1)
-  std::shared_ptr<gpu::Buffer> camera_;               // (Camera)
-  std::shared_ptr<gpu::Buffer> draw_indirect_;        // (DrawIndirect)
-  std::shared_ptr<gpu::Buffer> camera_stage_;         // (Camera)
+  std::shared_ptr<gpu::Buffer> visible_point_count_;  // (1 + V), total then per view
+  std::shared_ptr<gpu::Buffer> camera_;               // (V, Camera)
+  std::shared_ptr<gpu::Buffer> draw_indirect_;        // (V, DrawIndirect)
+  std::shared_ptr<gpu::Buffer> dispatch_indirect_;    // (DispatchIndirect), over visible instances
 
-  // Variable
+  // Variable, aliased by lifetime in one allocation. key_ lives from rank to sort and inverse_index_ from the inverse
+  // pass to projection; sort_storage_ lives during sort and instances_ from projection to drawing.
+  std::shared_ptr<gpu::Buffer> scratch_;
+  uint64_t scratch_size_ = 0;
+  uint64_t unaliased_scratch_size_ = 0;
+  // N is the capacity, the point count times the number of views sharing the storage.
   std::shared_ptr<gpu::Buffer> key_;            // (N)
   std::shared_ptr<gpu::Buffer> index_;          // (N)
   std::shared_ptr<gpu::Buffer> sort_storage_;   // (M)
   std::shared_ptr<gpu::Buffer> inverse_index_;  // (N)
-  std::shared_ptr<gpu::Buffer> instances_;      // (N, 12)
+  std::shared_ptr<gpu::Buffer> instances_;      // (N, 6), packed
 };
 
 }  // namespace core
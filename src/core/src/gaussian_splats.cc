@@ -8,16 +8,25 @@ namespace core {
 
 GaussianSplats::GaussianSplats(size_t size, uint32_t sh_degree, std::shared_ptr<gpu::Buffer> position,
                                std::shared_ptr<gpu::Buffer> cov3d, std::shared_ptr<gpu::Buffer> sh,
-                               std::shared_ptr<gpu::Buffer> opacity, std::shared_ptr<gpu::Buffer> index_buffer,
-                               std::shared_ptr<gpu::Task> task)
+                               std::shared_ptr<gpu::Buffer> opacity, std::shared_ptr<gpu::Task> task,
+                               std::shared_ptr<gpu::Buffer> chunk, std::shared_ptr<gpu::Buffer> sh_codebook)
     : size_(size),
       sh_degree_(sh_degree),
+      quantized_(chunk != nullptr),
+      interleaved_(opacity == nullptr),
+      has_sh_codebook_(sh_codebook != nullptr),
       position_(position),
       cov3d_(cov3d),
       sh_(sh),
       opacity_(opacity),
-      index_buffer_(index_buffer),
-      task_(task) {}
+      chunk_(chunk),
+      sh_codebook_(sh_codebook),
+      task_(task) {
+  for (const auto& buffer : buffers()) {
+    buffer_sizes_.push_back(buffer->size());
+    device_size_ += buffer->size();
+  }
+}
 
 GaussianSplats::~GaussianSplats() = default;
 
@@ -28,5 +37,35 @@ void GaussianSplats::Wait() {
   }
 }
 
+std::vector<std::shared_ptr<gpu::Buffer>> GaussianSplats::buffers() const {
+  if (!resident()) return {};
+  std::vector<std::shared_ptr<gpu::Buffer>> result = {position_, cov3d_, sh_};
+  if (!interleaved_) result.push_back(opacity_);
+  if (quantized_) result.push_back(chunk_);
+  if (has_sh_codebook_) result.push_back(sh_codebook_);
+  return result;
+}
+
+void GaussianSplats::Evict(std::shared_ptr<gpu::Buffer> host) {
+  host_ = host;
+  position_ = nullptr;
+  cov3d_ = nullptr;
+  sh_ = nullptr;
+  opacity_ = nullptr;
+  chunk_ = nullptr;
+  sh_codebook_ = nullptr;
+}
+
+void GaussianSplats::Restore(const std::vector<std::shared_ptr<gpu::Buffer>>& buffers) {
+  host_ = nullptr;
+  position_ = buffers[0];
+  cov3d_ = buffers[1];
+  sh_ = buffers[2];
+  size_t i = 3;
+  if (!interleaved_) opacity_ = buffers[i++];
+  if (quantized_) chunk_ = buffers[i++];
+  if (has_sh_codebook_) sh_codebook_ = buffers[i++];
+}
+
 }  // namespace core
 }  // namespace vkgs
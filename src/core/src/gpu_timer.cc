@@ -0,0 +1,54 @@
+#include "gpu_timer.h"
+
+#include <cmath>
+
+#include "vkgs/gpu/device.h"
+#include "vkgs/gpu/query_pool.h"
+
+namespace vkgs {
+namespace core {
+
+GpuTimer::GpuTimer(std::shared_ptr<gpu::Device> device) : device_(device) {}
+
+GpuTimer::~GpuTimer() = default;
+
+std::shared_ptr<gpu::QueryPool> GpuTimer::Begin(VkCommandBuffer cb) {
+  if (device_->compute_timestamp_valid_bits() == 0) return nullptr;
+
+  std::shared_ptr<gpu::QueryPool> queries;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_.empty()) {
+      queries = free_.back();
+      free_.pop_back();
+    }
+  }
+  if (queries == nullptr) queries = gpu::QueryPool::Create(device_, 2);
+  vkCmdResetQueryPool(cb, *queries, 0, 2);
+  return queries;
+}
+
+void GpuTimer::ResolveRank(std::shared_ptr<gpu::QueryPool> queries) {
+  uint64_t timestamps[2];
+  queries->GetTimestamps(timestamps);
+
+  // Ticks wrap around at the valid bits.
+  uint32_t valid_bits = device_->compute_timestamp_valid_bits();
+  uint64_t mask = valid_bits >= 64 ? ~0ull : (1ull << valid_bits) - 1;
+  uint64_t ticks = (timestamps[1] - timestamps[0]) & mask;
+  auto time = static_cast<uint64_t>(std::llround(ticks * static_cast<double>(device_->timestamp_period())));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.rank_count++;
+  stats_.rank_time += time;
+  stats_.rank_time_last = time;
+  free_.push_back(queries);
+}
+
+TimingStats GpuTimer::stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace core
+}  // namespace vkgs
@@ -0,0 +1,46 @@
+#ifndef VKGS_CORE_GPU_TIMER_H
+#define VKGS_CORE_GPU_TIMER_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "volk.h"
+
+#include "vkgs/core/timing_stats.h"
+
+namespace vkgs {
+namespace gpu {
+
+class Device;
+class QueryPool;
+
+}  // namespace gpu
+
+namespace core {
+
+// Pairs of timestamp queries around passes on the compute queue. Thread-safe, since queries are resolved by task
+// callbacks, which may run without the renderer mutex.
+class GpuTimer {
+ public:
+  explicit GpuTimer(std::shared_ptr<gpu::Device> device);
+  ~GpuTimer();
+
+  // Two queries reset in cb, to be written before and after the pass, or nullptr if timestamps are unsupported.
+  std::shared_ptr<gpu::QueryPool> Begin(VkCommandBuffer cb);
+  // Counts the rank pass timed by queries, whose commands are done, and returns them to the pool.
+  void ResolveRank(std::shared_ptr<gpu::QueryPool> queries);
+
+  TimingStats stats();
+
+ private:
+  std::shared_ptr<gpu::Device> device_;
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<gpu::QueryPool>> free_;
+  TimingStats stats_;
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_GPU_TIMER_H
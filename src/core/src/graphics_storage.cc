@@ -2,6 +2,8 @@
 
 #include "vkgs/gpu/image.h"
 
+#include "memory_tag.h"
+
 namespace vkgs {
 namespace core {
 
@@ -20,6 +22,9 @@ void GraphicsStorage::Update(uint32_t width, uint32_t height) {
           VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
       depth_image_ = gpu::Image::Create(device_, VK_FORMAT_D32_SFLOAT, width, height,
                                          VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+      image_->set_tag(kMemoryTagImages);
+      image_u8_->set_tag(kMemoryTagImages);
+      depth_image_->set_tag(kMemoryTagImages);
     } else {
       // Reset to null if dimensions are invalid
       image_.reset();
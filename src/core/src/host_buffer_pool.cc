@@ -0,0 +1,58 @@
+#include "host_buffer_pool.h"
+
+#include "vkgs/gpu/buffer.h"
+#include "vkgs/gpu/task.h"
+
+namespace vkgs {
+namespace core {
+namespace {
+
+constexpr uint64_t kMinBucketSize = 64 * 1024;
+
+uint64_t BucketSize(uint64_t size) {
+  uint64_t bucket = kMinBucketSize;
+  while (bucket < size) bucket *= 2;
+  return bucket;
+}
+
+}  // namespace
+
+HostBufferPool::HostBufferPool(std::shared_ptr<gpu::Device> device, VkBufferUsageFlags usage, uint32_t tag)
+    : device_(device), usage_(usage), tag_(tag) {}
+
+HostBufferPool::~HostBufferPool() = default;
+
+std::shared_ptr<gpu::Buffer> HostBufferPool::Acquire(uint64_t size) {
+  Reclaim();
+
+  uint64_t bucket = BucketSize(size);
+  auto& buffers = free_[bucket];
+  if (buffers.empty()) {
+    auto buffer = gpu::Buffer::Create(device_, usage_, bucket, true);
+    buffer->set_tag(tag_);
+    return buffer;
+  }
+
+  auto buffer = buffers.back();
+  buffers.pop_back();
+  return buffer;
+}
+
+void HostBufferPool::Release(std::shared_ptr<gpu::Buffer> buffer, std::shared_ptr<gpu::Task> task) {
+  in_flight_.push_back({buffer, task});
+}
+
+void HostBufferPool::Reclaim() {
+  for (size_t i = 0; i < in_flight_.size();) {
+    if (in_flight_[i].task->IsDone()) {
+      free_[in_flight_[i].buffer->size()].push_back(in_flight_[i].buffer);
+      std::swap(in_flight_[i], in_flight_.back());
+      in_flight_.pop_back();
+    } else {
+      ++i;
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace vkgs
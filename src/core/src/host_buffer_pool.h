@@ -0,0 +1,54 @@
+#ifndef VKGS_CORE_HOST_BUFFER_POOL_H
+#define VKGS_CORE_HOST_BUFFER_POOL_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "volk.h"
+
+namespace vkgs {
+namespace gpu {
+
+class Device;
+class Buffer;
+class Task;
+
+}  // namespace gpu
+
+namespace core {
+
+// Mapped host buffers of one usage, such as upload staging or readback, in power-of-two size buckets. A released
+// buffer returns to its bucket once the task using it is done. Not thread-safe, guarded by the renderer mutex.
+class HostBufferPool {
+ public:
+  // Buffers are created with usage and counted under memory tag.
+  HostBufferPool(std::shared_ptr<gpu::Device> device, VkBufferUsageFlags usage, uint32_t tag);
+  ~HostBufferPool();
+
+  // A mapped buffer of at least size bytes.
+  std::shared_ptr<gpu::Buffer> Acquire(uint64_t size);
+
+  void Release(std::shared_ptr<gpu::Buffer> buffer, std::shared_ptr<gpu::Task> task);
+
+ private:
+  struct InFlight {
+    std::shared_ptr<gpu::Buffer> buffer;
+    std::shared_ptr<gpu::Task> task;
+  };
+
+  // Returns buffers of done tasks to their buckets.
+  void Reclaim();
+
+  std::shared_ptr<gpu::Device> device_;
+  VkBufferUsageFlags usage_;
+  uint32_t tag_;
+  std::map<uint64_t, std::vector<std::shared_ptr<gpu::Buffer>>> free_;  // by bucket size
+  std::vector<InFlight> in_flight_;
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_HOST_BUFFER_POOL_H
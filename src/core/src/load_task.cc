@@ -0,0 +1,59 @@
+#include "vkgs/core/load_task.h"
+
+#include "vkgs/core/gaussian_splats.h"
+
+namespace vkgs {
+namespace core {
+
+LoadTask::LoadTask() = default;
+
+LoadTask::~LoadTask() {
+  Cancel();
+  Wait();
+}
+
+float LoadTask::progress() const noexcept {
+  uint64_t point_count = point_count_;
+  if (point_count == 0) return done_ ? 1.f : 0.f;
+  return static_cast<float>(points_parsed_) / point_count;
+}
+
+void LoadTask::Wait() {
+  if (thread_.joinable()) thread_.join();
+}
+
+std::shared_ptr<GaussianSplats> LoadTask::Get() {
+  Wait();
+  if (exception_) std::rethrow_exception(exception_);
+  return splats_;
+}
+
+void LoadTask::Start(std::function<std::shared_ptr<GaussianSplats>(LoadTask*)> load) {
+  thread_ = std::thread([this, load = std::move(load)] {
+    try {
+      splats_ = load(this);
+    } catch (...) {
+      exception_ = std::current_exception();
+    }
+    done_ = true;
+  });
+}
+
+void LoadTask::SetTotal(uint64_t bytes_total, uint64_t point_count) noexcept {
+  bytes_total_ = bytes_total;
+  point_count_ = point_count;
+}
+
+void LoadTask::AddProgress(uint64_t bytes_read, uint64_t points_parsed) noexcept {
+  bytes_read_ += bytes_read;
+  points_parsed_ += points_parsed;
+}
+
+void LoadTask::SetBounds(const glm::vec3& min, const glm::vec3& max) noexcept {
+  has_bounds_ = true;
+  bounds_min_ = min;
+  bounds_max_ = max;
+}
+
+}  // namespace core
+}  // namespace vkgs
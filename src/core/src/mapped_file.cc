@@ -0,0 +1,101 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vkgs {
+namespace core {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+  file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file_ == INVALID_HANDLE_VALUE) {
+    file_ = nullptr;
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file_, &size)) {
+    CloseHandle(file_);
+    throw std::runtime_error("Failed to stat file: " + path);
+  }
+  size_ = static_cast<size_t>(size.QuadPart);
+  if (size_ == 0) return;
+
+  mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping_ == NULL) {
+    CloseHandle(file_);
+    throw std::runtime_error("Failed to map file: " + path);
+  }
+
+  data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+  if (data_ == NULL) {
+    CloseHandle(mapping_);
+    CloseHandle(file_);
+    throw std::runtime_error("Failed to map file: " + path);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data_) UnmapViewOfFile(data_);
+  if (mapping_) CloseHandle(mapping_);
+  if (file_) CloseHandle(file_);
+}
+
+void MappedFile::Release(size_t offset, size_t size) {
+  // Mapped file pages are reclaimed by the system on demand; nothing to do.
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+  fd_ = open(path.c_str(), O_RDONLY);
+  if (fd_ < 0) throw std::runtime_error("Failed to open file: " + path);
+
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    close(fd_);
+    throw std::runtime_error("Failed to stat file: " + path);
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ == 0) return;
+
+  void* ptr = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (ptr == MAP_FAILED) {
+    close(fd_);
+    throw std::runtime_error("Failed to map file: " + path);
+  }
+  data_ = static_cast<const char*>(ptr);
+
+  madvise(ptr, size_, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile() {
+  if (data_) munmap(const_cast<char*>(data_), size_);
+  if (fd_ >= 0) close(fd_);
+}
+
+void MappedFile::Release(size_t offset, size_t size) {
+  // madvise requires page-aligned ranges; only drop pages fully inside the range.
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t begin = (offset + page_size - 1) / page_size * page_size;
+  size_t end = std::min(offset + size, size_) / page_size * page_size;
+  if (begin < end) madvise(const_cast<char*>(data_) + begin, end - begin, MADV_DONTNEED);
+}
+
+#endif
+
+}  // namespace core
+}  // namespace vkgs
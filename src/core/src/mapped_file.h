@@ -0,0 +1,41 @@
+#ifndef VKGS_CORE_MAPPED_FILE_H
+#define VKGS_CORE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vkgs {
+namespace core {
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+
+  // Hint that [offset, offset + size) is no longer needed, so the pages can be dropped from the working set.
+  void Release(size_t offset, size_t size);
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+#ifdef _WIN32
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_MAPPED_FILE_H
@@ -0,0 +1,22 @@
+#ifndef VKGS_CORE_MEMORY_TAG_H
+#define VKGS_CORE_MEMORY_TAG_H
+
+#include <cstdint>
+
+namespace vkgs {
+namespace core {
+
+// Tags of buffers and images for Renderer::GetMemoryStats, below gpu::kMemoryTagCount.
+enum MemoryTag : uint32_t {
+  kMemoryTagOther = 0,
+  kMemoryTagSplats = 1,
+  kMemoryTagSortScratch = 2,
+  kMemoryTagImages = 3,
+  kMemoryTagStaging = 4,
+  kMemoryTagReadback = 5,
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_MEMORY_TAG_H
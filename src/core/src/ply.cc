@@ -0,0 +1,379 @@
+#include "ply.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <glm/gtc/packing.hpp>
+
+namespace vkgs {
+namespace core {
+namespace {
+
+bool ParsePlyType(const std::string& name, PlyType* type) {
+  static const std::unordered_map<std::string, PlyType> types = {
+      {"char", PlyType::kChar},     {"int8", PlyType::kChar},      {"uchar", PlyType::kUchar},
+      {"uint8", PlyType::kUchar},   {"short", PlyType::kShort},    {"int16", PlyType::kShort},
+      {"ushort", PlyType::kUshort}, {"uint16", PlyType::kUshort},  {"int", PlyType::kInt},
+      {"int32", PlyType::kInt},     {"uint", PlyType::kUint},      {"uint32", PlyType::kUint},
+      {"float", PlyType::kFloat},   {"float32", PlyType::kFloat},  {"double", PlyType::kDouble},
+      {"float64", PlyType::kDouble}, {"half", PlyType::kHalf},     {"float16", PlyType::kHalf},
+  };
+  auto it = types.find(name);
+  if (it == types.end()) return false;
+  *type = it->second;
+  return true;
+}
+
+// Range of raw integer values, mapped to [min, max] by a quantize comment.
+std::pair<double, double> PlyTypeRange(PlyType type) {
+  switch (type) {
+    case PlyType::kChar:
+      return {-128., 127.};
+    case PlyType::kUchar:
+      return {0., 255.};
+    case PlyType::kShort:
+      return {-32768., 32767.};
+    case PlyType::kUshort:
+      return {0., 65535.};
+    case PlyType::kInt:
+      return {-2147483648., 2147483647.};
+    case PlyType::kUint:
+      return {0., 4294967295.};
+    default:
+      return {0., 1.};
+  }
+}
+
+bool IsPlyIntegerType(PlyType type) {
+  return type != PlyType::kFloat && type != PlyType::kDouble && type != PlyType::kHalf;
+}
+
+template <typename T>
+void Store(char* dst, T value) {
+  std::memcpy(dst, &value, sizeof(T));
+}
+
+template <typename T>
+T Load(const char* src) {
+  T value;
+  std::memcpy(&value, src, sizeof(T));
+  return value;
+}
+
+// Integer token of type T. Throws on a token that is not entirely a number or does not fit in T.
+template <typename T>
+T ParseInteger(const char* token) {
+  char* end = nullptr;
+  errno = 0;
+  if constexpr (std::is_signed_v<T>) {
+    long long value = std::strtoll(token, &end, 10);
+    if (end != token && *end == '\0' && errno != ERANGE && value >= std::numeric_limits<T>::min() &&
+        value <= std::numeric_limits<T>::max())
+      return static_cast<T>(value);
+  } else {
+    // strtoull accepts a sign and negates the result; unsigned values must not have one.
+    unsigned long long value = std::strtoull(token, &end, 10);
+    if (end != token && *end == '\0' && errno != ERANGE && token[0] != '-' &&
+        value <= std::numeric_limits<T>::max())
+      return static_cast<T>(value);
+  }
+  throw std::runtime_error(std::string("Invalid PLY integer value: ") + token);
+}
+
+// Floating-point token of type T. Underflow to a denormal or zero is accepted, overflow is not.
+template <typename T>
+T ParseFloating(const char* token) {
+  char* end = nullptr;
+  errno = 0;
+  T value;
+  if constexpr (std::is_same_v<T, float>)
+    value = std::strtof(token, &end);
+  else
+    value = std::strtod(token, &end);
+  if (end == token || *end != '\0' || (errno == ERANGE && std::isinf(value)))
+    throw std::runtime_error(std::string("Invalid PLY floating-point value: ") + token);
+  return value;
+}
+
+}  // namespace
+
+uint32_t PlyTypeSize(PlyType type) {
+  switch (type) {
+    case PlyType::kChar:
+    case PlyType::kUchar:
+      return 1;
+    case PlyType::kShort:
+    case PlyType::kUshort:
+    case PlyType::kHalf:
+      return 2;
+    case PlyType::kInt:
+    case PlyType::kUint:
+    case PlyType::kFloat:
+      return 4;
+    case PlyType::kDouble:
+      return 8;
+  }
+  return 0;
+}
+
+double ReadPlyValue(const char* data, PlyType type) {
+  switch (type) {
+    case PlyType::kChar:
+      return Load<int8_t>(data);
+    case PlyType::kUchar:
+      return Load<uint8_t>(data);
+    case PlyType::kShort:
+      return Load<int16_t>(data);
+    case PlyType::kUshort:
+      return Load<uint16_t>(data);
+    case PlyType::kInt:
+      return Load<int32_t>(data);
+    case PlyType::kUint:
+      return Load<uint32_t>(data);
+    case PlyType::kFloat:
+      return Load<float>(data);
+    case PlyType::kDouble:
+      return Load<double>(data);
+    case PlyType::kHalf:
+      return glm::unpackHalf1x16(Load<uint16_t>(data));
+  }
+  return 0.;
+}
+
+const PlyProperty* PlyElement::FindProperty(const std::string& name) const {
+  for (const auto& property : properties) {
+    if (property.name == name) return &property;
+  }
+  return nullptr;
+}
+
+const PlyElement* PlyHeader::FindElement(const std::string& name) const {
+  for (const auto& element : elements) {
+    if (element.name == name) return &element;
+  }
+  return nullptr;
+}
+
+PlyHeader ParsePlyHeader(std::string_view contents, const std::string& path) {
+  auto error = [&path](const std::string& message) {
+    return std::runtime_error("Invalid PLY header (" + message + "): " + path);
+  };
+
+  PlyHeader header;
+  bool has_format = false;
+  bool has_end_header = false;
+  std::unordered_map<std::string, std::pair<float, float>> quantize;
+
+  size_t pos = 0;
+  for (int line_index = 0; pos < contents.size(); ++line_index) {
+    auto eol = contents.find('\n', pos);
+    if (eol == std::string_view::npos) break;
+    std::string line(contents.substr(pos, eol - pos));
+    pos = eol + 1;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    if (line_index == 0) {
+      if (line != "ply") throw error("missing magic number");
+      continue;
+    }
+
+    std::istringstream iss(line);
+    std::string word;
+    iss >> word;
+    if (word == "format") {
+      std::string format, version;
+      iss >> format >> version;
+      if (format == "ascii") {
+        header.format = PlyFormat::kAscii;
+      } else if (format == "binary_little_endian") {
+        header.format = PlyFormat::kBinaryLittleEndian;
+      } else if (format == "binary_big_endian") {
+        header.format = PlyFormat::kBinaryBigEndian;
+      } else {
+        throw error("unknown format \"" + format + "\"");
+      }
+      if (version != "1.0") throw error("unsupported version \"" + version + "\"");
+      has_format = true;
+    } else if (word == "element") {
+      PlyElement element;
+      if (!(iss >> element.name >> element.count)) throw error("bad element line \"" + line + "\"");
+      if (header.FindElement(element.name)) throw error("duplicate element \"" + element.name + "\"");
+      header.elements.push_back(std::move(element));
+    } else if (word == "property") {
+      if (header.elements.empty()) throw error("property before any element");
+      auto& element = header.elements.back();
+
+      std::string type_name;
+      iss >> type_name;
+      PlyProperty property;
+      if (type_name == "list") {
+        std::string count_type, value_type;
+        PlyType type;
+        if (!(iss >> count_type >> value_type >> property.name) || !ParsePlyType(count_type, &type) ||
+            !ParsePlyType(value_type, &property.type)) {
+          throw error("bad property line \"" + line + "\"");
+        }
+        if (element.FindProperty(property.name)) throw error("duplicate property \"" + property.name + "\"");
+        property.is_list = true;
+        element.has_list = true;
+        element.properties.push_back(std::move(property));
+        continue;
+      }
+
+      if (!(iss >> property.name) || !ParsePlyType(type_name, &property.type)) {
+        throw error("bad property line \"" + line + "\"");
+      }
+      if (element.FindProperty(property.name)) throw error("duplicate property \"" + property.name + "\"");
+      property.offset = element.stride;
+      element.stride += PlyTypeSize(property.type);
+      element.properties.push_back(std::move(property));
+    } else if (word == "comment") {
+      std::string keyword;
+      iss >> keyword;
+      if (keyword == "quantize") {
+        std::string name;
+        float min, max;
+        if (!(iss >> name >> min >> max)) throw error("bad quantize comment \"" + line + "\"");
+        quantize[name] = {min, max};
+      }
+    } else if (word == "obj_info" || word.empty()) {
+      // ignore
+    } else if (word == "end_header") {
+      has_end_header = true;
+      break;
+    } else {
+      throw error("unknown keyword \"" + word + "\"");
+    }
+  }
+
+  if (!has_end_header) throw error("missing end_header");
+  if (!has_format) throw error("missing format");
+  header.body_offset = pos;
+
+  // Quantize comments name vertex properties.
+  for (const auto& [name, range] : quantize) {
+    PlyProperty* property = nullptr;
+    for (auto& element : header.elements) {
+      for (auto& p : element.properties) {
+        if (p.name == name && !p.is_list && element.name == "vertex") property = &p;
+      }
+    }
+    if (property == nullptr) throw error("quantize comment for unknown property \"" + name + "\"");
+    if (!IsPlyIntegerType(property->type)) throw error("quantize comment for non-integer property \"" + name + "\"");
+
+    auto [type_min, type_max] = PlyTypeRange(property->type);
+    double scale = (static_cast<double>(range.second) - range.first) / (type_max - type_min);
+    property->scale = static_cast<float>(scale);
+    property->bias = static_cast<float>(range.first - type_min * scale);
+  }
+
+  return header;
+}
+
+size_t PlyElementOffset(const PlyHeader& header, const std::string& element) {
+  size_t offset = header.body_offset;
+  for (const auto& e : header.elements) {
+    if (e.name == element) return offset;
+    if (e.has_list) {
+      throw std::runtime_error("Cannot skip PLY element with list properties: " + e.name);
+    }
+    offset += e.stride * e.count;
+  }
+  throw std::runtime_error("PLY element not found: " + element);
+}
+
+PlyAsciiReader::PlyAsciiReader(const PlyHeader& header, std::string_view contents, const std::string& element)
+    : contents_(contents), pos_(header.body_offset) {
+  for (const auto& e : header.elements) {
+    if (e.name == element) {
+      if (e.has_list) throw std::runtime_error("PLY list properties are not supported in element: " + element);
+      element_ = &e;
+      return;
+    }
+
+    // Skip records of other elements. A list is its count followed by that many values.
+    for (size_t i = 0; i < e.count; ++i) {
+      for (const auto& property : e.properties) {
+        uint64_t n = property.is_list ? ParseInteger<uint64_t>(Next()) : 1;
+        for (size_t j = 0; j < n; ++j) Next();
+      }
+    }
+  }
+
+  throw std::runtime_error("PLY element not found: " + element);
+}
+
+const char* PlyAsciiReader::Next() {
+  // Whitespace-separated tokens of a body that is not null-terminated.
+  while (pos_ < contents_.size() && std::isspace(static_cast<unsigned char>(contents_[pos_]))) pos_++;
+  if (pos_ == contents_.size()) throw std::runtime_error("PLY file is truncated");
+  size_t begin = pos_;
+  while (pos_ < contents_.size() && !std::isspace(static_cast<unsigned char>(contents_[pos_]))) pos_++;
+  token_.assign(contents_.data() + begin, pos_ - begin);
+  return token_.c_str();
+}
+
+void PlyAsciiReader::Read(size_t count, char* data) {
+  if (record_ + count > element_->count) throw std::runtime_error("PLY records read past element: " + element_->name);
+
+  for (size_t i = 0; i < count; ++i) {
+    char* record = data + static_cast<size_t>(element_->stride) * i;
+    for (const auto& property : element_->properties) {
+      const char* token = Next();
+      char* dst = record + property.offset;
+      switch (property.type) {
+        case PlyType::kChar:
+          Store(dst, ParseInteger<int8_t>(token));
+          break;
+        case PlyType::kUchar:
+          Store(dst, ParseInteger<uint8_t>(token));
+          break;
+        case PlyType::kShort:
+          Store(dst, ParseInteger<int16_t>(token));
+          break;
+        case PlyType::kUshort:
+          Store(dst, ParseInteger<uint16_t>(token));
+          break;
+        case PlyType::kInt:
+          Store(dst, ParseInteger<int32_t>(token));
+          break;
+        case PlyType::kUint:
+          Store(dst, ParseInteger<uint32_t>(token));
+          break;
+        case PlyType::kFloat:
+          Store(dst, ParseFloating<float>(token));
+          break;
+        case PlyType::kDouble:
+          Store(dst, ParseFloating<double>(token));
+          break;
+        case PlyType::kHalf:
+          Store(dst, static_cast<uint16_t>(glm::packHalf1x16(ParseFloating<float>(token))));
+          break;
+      }
+    }
+  }
+  record_ += count;
+}
+
+void SwapPlyEndian(const PlyElement& element, char* data, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    char* record = data + element.stride * i;
+    for (const auto& property : element.properties) {
+      auto size = PlyTypeSize(property.type);
+      std::reverse(record + property.offset, record + property.offset + size);
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace vkgs
@@ -0,0 +1,105 @@
+#ifndef VKGS_CORE_PLY_H
+#define VKGS_CORE_PLY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vkgs {
+namespace core {
+
+enum class PlyFormat {
+  kAscii,
+  kBinaryLittleEndian,
+  kBinaryBigEndian,
+};
+
+// Values must match the type constants in parse_ply.comp.
+enum class PlyType : uint32_t {
+  kChar = 0,
+  kUchar = 1,
+  kShort = 2,
+  kUshort = 3,
+  kInt = 4,
+  kUint = 5,
+  kFloat = 6,
+  kDouble = 7,
+  kHalf = 8,
+};
+
+uint32_t PlyTypeSize(PlyType type);
+
+// Raw value of type at data, in little-endian byte order, before dequantization.
+double ReadPlyValue(const char* data, PlyType type);
+
+struct PlyProperty {
+  std::string name;
+  PlyType type = PlyType::kFloat;
+  uint32_t offset = 0;  // byte offset within an element
+  bool is_list = false;  // list property, type is the value type and offset is unused
+
+  // Linear dequantization, value = raw * scale + bias, set by "comment quantize <property> <min> <max>".
+  // Integer values are mapped from [0, type max] (or [type min, type max] for signed types) to [min, max].
+  float scale = 1.f;
+  float bias = 0.f;
+};
+
+struct PlyElement {
+  std::string name;
+  size_t count = 0;
+  uint32_t stride = 0;  // byte size of one element, valid when there is no list property
+  bool has_list = false;
+  std::vector<PlyProperty> properties;
+
+  const PlyProperty* FindProperty(const std::string& name) const;
+};
+
+struct PlyHeader {
+  PlyFormat format = PlyFormat::kBinaryLittleEndian;
+  std::vector<PlyElement> elements;
+  size_t body_offset = 0;  // byte offset of the first element data in the file
+
+  const PlyElement* FindElement(const std::string& name) const;
+};
+
+// Parses and validates a PLY header. Throws std::runtime_error on malformed headers.
+PlyHeader ParsePlyHeader(std::string_view contents, const std::string& path);
+
+// Byte offset of the first record of element in the file. Throws if a preceding element is not fixed-size.
+size_t PlyElementOffset(const PlyHeader& header, const std::string& element);
+
+// Reads the records of one element of an ASCII body in order, converting them to the little-endian binary layout of
+// the element, one record per stride. Only the records being read are converted, so memory stays bounded by the caller.
+class PlyAsciiReader {
+ public:
+  // Skips the records of the elements before element. Throws if it is missing, has list properties, or the body is
+  // malformed before it.
+  PlyAsciiReader(const PlyHeader& header, std::string_view contents, const std::string& element);
+
+  // Index of the next record.
+  size_t record() const noexcept { return record_; }
+  // Byte offset in contents of the end of the last token read.
+  size_t position() const noexcept { return pos_; }
+
+  // Converts the next count records to data. Throws on malformed values or a truncated body.
+  void Read(size_t count, char* data);
+
+ private:
+  const char* Next();
+
+  const PlyElement* element_ = nullptr;
+  std::string_view contents_;
+  size_t pos_ = 0;
+  size_t record_ = 0;
+  std::string token_;
+};
+
+// Swaps the byte order of count records of element in place.
+void SwapPlyEndian(const PlyElement& element, char* data, size_t count);
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_PLY_H
@@ -6,15 +6,18 @@ namespace vkgs {
 namespace core {
 
 RenderedImage::RenderedImage(uint32_t width, uint32_t height, std::shared_ptr<gpu::Task> task)
-    : width_(width), height_(height), task_(task) {}
+    : width_(width), height_(height) {
+  if (task) tasks_.push_back(task);
+}
+
+RenderedImage::RenderedImage(uint32_t width, uint32_t height, std::vector<std::shared_ptr<gpu::Task>> tasks)
+    : width_(width), height_(height), tasks_(tasks) {}
 
 RenderedImage::~RenderedImage() {}
 
 void RenderedImage::Wait() {
-  if (task_) {
-    task_->Wait();
-    task_ = nullptr;
-  }
+  for (const auto& task : tasks_) task->Wait();
+  tasks_.clear();
 }
 
 }  // namespace core
@@ -1,15 +1,24 @@
 #include "vkgs/core/renderer.h"
 
+#include <array>
+#include <cmath>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <unordered_map>
 #include <sstream>
+#include <string_view>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <limits>
+#include <mutex>
+#include <thread>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include "volk.h"
 
@@ -17,6 +26,7 @@
 #include "vkgs/gpu/image.h"
 #include "vkgs/gpu/device.h"
 #include "vkgs/gpu/semaphore.h"
+#include "vkgs/gpu/task.h"
 #include "vkgs/gpu/fence.h"
 #include "vkgs/gpu/queue.h"
 #include "vkgs/gpu/command.h"
@@ -24,14 +34,34 @@
 #include "vkgs/gpu/pipeline_layout.h"
 #include "vkgs/gpu/compute_pipeline.h"
 #include "vkgs/gpu/graphics_pipeline.h"
+#include "vkgs/gpu/query_pool.h"
 
 #include "vkgs/core/gaussian_splats.h"
+#include "vkgs/core/load_task.h"
 #include "vkgs/core/rendered_image.h"
+#include "generated/morton.h"
+#include "generated/morton_bounds.h"
 #include "generated/parse_ply.h"
+#include "generated/parse_compressed_ply.h"
 #include "generated/parse_data.h"
 #include "generated/rank.h"
+#include "generated/rank_interleaved.h"
+#include "generated/rank_quantized.h"
+#include "generated/rank_subgroup.h"
+#include "generated/rank_interleaved_subgroup.h"
+#include "generated/rank_quantized_subgroup.h"
+#include "generated/sh_codebook.h"
+#include "generated/interleave.h"
 #include "generated/inverse_index.h"
+#include "generated/dispatch_indirect.h"
 #include "generated/projection.h"
+#include "generated/projection_interleaved.h"
+#include "generated/projection_interleaved_sh_codebook.h"
+#include "generated/projection_quantized.h"
+#include "generated/projection_quantized_sh_codebook.h"
+#include "generated/projection_sh_codebook.h"
+#include "generated/quantize.h"
+#include "generated/reorder.h"
 #include "generated/splat_vert.h"
 #include "generated/splat_frag.h"
 #include "generated/splat_background_vert.h"
@@ -40,20 +70,96 @@
 #include "compute_storage.h"
 #include "graphics_storage.h"
 #include "transfer_storage.h"
+#include "mapped_file.h"
+#include "residency_manager.h"
+#include "memory_tag.h"
+#include "upload_ring.h"
+#include "host_buffer_pool.h"
+#include "scratch_pool.h"
+#include "gpu_timer.h"
+#include "ply.h"
+#include "splat_file.h"
 #include "struct.h"
 
 namespace {
 
+constexpr size_t kStagingChunkSize = 64 * 1024 * 1024;
+constexpr uint32_t kStagingRingSize = 3;
+
+// Offset alignment of pieces sharing a staging chunk, the largest minStorageBufferOffsetAlignment allowed.
+constexpr uint64_t kParseChunkAlignment = 256;
+
+// Number of points sharing quantization bounds in compressed PLY.
+constexpr uint32_t kCompressedPlyChunkSize = 256;
+
+// Number of points sharing a center and a cov3d scale in quantized splats, the workgroup size of quantize.comp.
+constexpr uint32_t kQuantizeChunkSize = 256;
+
+// Number of f16vec4 per point of packed SH, by SH degree.
+constexpr uint32_t kShPackedSizes[] = {1, 3, 7, 12};
+
+// Training samples per codeword and k-means iterations of CompressSh.
+constexpr uint32_t kShCodebookSamplesPerCode = 32;
+constexpr uint32_t kShCodebookIterations = 8;
+
+// Host memory for per-draw camera uploads, per frame in flight. A DrawBatch group takes kMaxViewCount cameras, 2.5 KiB
+// with the ring alignment, and a single view takes 256 bytes, so a frame has room for 12 groups or 128 single views.
+// Uploads beyond that wait for the oldest submission.
+constexpr uint64_t kUploadRingSizePerFrame = 32 * 1024;
+
+// Bytes of compute scratch of views of DrawBatch sorted together, up to kMaxViewCount views. Large scenes fall back to
+// one view at a time, where per-view CPU cost is small next to GPU time.
+constexpr uint64_t kBatchScratchSize = 1024ull * 1024 * 1024;
+
+// Usage of GaussianSplats buffers; transfer for uploads and SaveSplats readback.
+constexpr VkBufferUsageFlags kSplatBufferUsage =
+    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+// SH degree and storage dimension for packing with f16vec4 of data having f_rest_[0..K).
+void GetShLayout(int K, int* sh_degree_data, int* sh_packed_size) {
+  switch (K) {
+    case 0:  // no f_rest
+      *sh_degree_data = 0;
+      *sh_packed_size = 1;
+      break;
+    case 9:  // f_rest_[0..9)
+      *sh_degree_data = 1;
+      *sh_packed_size = 3;
+      break;
+    case 24:  // f_rest_[0..24)
+      *sh_degree_data = 2;
+      *sh_packed_size = 7;
+      break;
+    case 45:  // f_rest_[0..45)
+      *sh_degree_data = 3;
+      *sh_packed_size = 12;
+      break;
+    default:
+      throw std::runtime_error("Unsupported SH degree for having f_rest_[0.." + std::to_string(K - 1) + "]");
+  }
+}
+
+// Byte offsets of buffers packed in host memory while evicted. Returns the total size.
+uint64_t PackedOffsets(const std::vector<uint64_t>& sizes, std::vector<uint64_t>* offsets) {
+  uint64_t size = 0;
+  offsets->resize(sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    size = (size + kParseChunkAlignment - 1) / kParseChunkAlignment * kParseChunkAlignment;
+    (*offsets)[i] = size;
+    size += sizes[i];
+  }
+  return size;
+}
+
 auto WorkgroupSize(size_t count, uint32_t local_size) { return (count + local_size - 1) / local_size; }
 
+// Pushes buffers to consecutive bindings from first_binding, keeping other bindings pushed before.
 void cmdPushDescriptorSet(VkCommandBuffer cb, VkPipelineBindPoint bind_point, VkPipelineLayout pipeline_layout,
-                          const std::vector<VkBuffer>& buffers) {
-  std::vector<VkDescriptorBufferInfo> buffer_infos(buffers.size());
-  std::vector<VkWriteDescriptorSet> writes(buffers.size());
-  for (int i = 0; i < buffers.size(); ++i) {
-    buffer_infos[i] = {buffers[i], 0, VK_WHOLE_SIZE};
+                          const std::vector<VkDescriptorBufferInfo>& buffer_infos, uint32_t first_binding = 0) {
+  std::vector<VkWriteDescriptorSet> writes(buffer_infos.size());
+  for (size_t i = 0; i < buffer_infos.size(); ++i) {
     writes[i] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
-    writes[i].dstBinding = i;
+    writes[i].dstBinding = first_binding + i;
     writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
     writes[i].descriptorCount = 1;
     writes[i].pBufferInfo = &buffer_infos[i];
@@ -61,24 +167,345 @@ void cmdPushDescriptorSet(VkCommandBuffer cb, VkPipelineBindPoint bind_point, Vk
   vkCmdPushDescriptorSet(cb, bind_point, pipeline_layout, 0, writes.size(), writes.data());
 }
 
+void cmdPushDescriptorSet(VkCommandBuffer cb, VkPipelineBindPoint bind_point, VkPipelineLayout pipeline_layout,
+                          const std::vector<VkBuffer>& buffers, uint32_t first_binding = 0) {
+  std::vector<VkDescriptorBufferInfo> buffer_infos(buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i) buffer_infos[i] = {buffers[i], 0, VK_WHOLE_SIZE};
+  cmdPushDescriptorSet(cb, bind_point, pipeline_layout, buffer_infos, first_binding);
+}
+
+// Runs fn(i) for i in [0, count) on up to hardware_concurrency threads. Rethrows the first exception.
+void ParallelFor(size_t count, const std::function<void(size_t)>& fn) {
+  size_t thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), count);
+  std::atomic<size_t> next{0};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  auto worker = [&] {
+    for (size_t i = next++; i < count; i = next++) {
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (!exception) exception = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+  if (exception) std::rethrow_exception(exception);
+}
+
 }  // namespace
 
 namespace vkgs {
 namespace core {
+namespace {
+
+// Byte sizes of the GaussianSplats buffers, in the order of SplatFileSection.
+std::array<uint64_t, kSplatFileSectionCount> SplatSectionSizes(uint64_t point_count, uint32_t sh_degree) {
+  return {point_count * 3 * sizeof(float), point_count * 6 * sizeof(float),
+          point_count * kShPackedSizes[sh_degree] * 4 * sizeof(uint16_t), point_count * sizeof(float)};
+}
+
+// Byte offsets of the sections in the .vkgs layout, after the header. Returns the total size.
+uint64_t SplatSectionOffsets(const std::array<uint64_t, kSplatFileSectionCount>& sizes,
+                             std::array<uint64_t, kSplatFileSectionCount>* offsets) {
+  uint64_t size = sizeof(SplatFileHeader);
+  for (uint32_t i = 0; i < kSplatFileSectionCount; ++i) {
+    size = (size + kSplatFileAlignment - 1) / kSplatFileAlignment * kSplatFileAlignment;
+    (*offsets)[i] = size;
+    size += sizes[i];
+  }
+  return size;
+}
+
+// Records commands and submits them to the compute queue, followed by a barrier making their writes visible to later
+// compute, transfer and host reads. The returned task keeps objects alive until completion.
+std::shared_ptr<gpu::Task> SubmitCompute(gpu::Device& device, gpu::TaskMonitor& task_monitor,
+                                         const std::function<void(VkCommandBuffer)>& record,
+                                         std::vector<std::shared_ptr<gpu::Object>> objects) {
+  auto cq = device.compute_queue();
+  auto cb = cq->AllocateCommandBuffer();
+  auto fence = device.AllocateFence();
+
+  VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  vkBeginCommandBuffer(*cb, &begin_info);
+
+  record(*cb);
+
+  VkMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  barrier.dstStageMask =
+      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_HOST_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_HOST_READ_BIT;
+  VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &barrier;
+  vkCmdPipelineBarrier2(*cb, &dependency_info);
+
+  vkEndCommandBuffer(*cb);
+
+  VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+  command_buffer_info.commandBuffer = *cb;
+
+  VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+  submit.commandBufferInfoCount = 1;
+  submit.pCommandBufferInfos = &command_buffer_info;
+  vkQueueSubmit2(*cq, 1, &submit, *fence);
+  objects.push_back(cb);
+  return task_monitor.Add(fence, objects);
+}
+
+// Makes compute and transfer writes visible to the next compute dispatch or transfer in the same command buffer.
+void ComputeBarrier(VkCommandBuffer cb) {
+  VkMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_READ_BIT |
+                          VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &barrier;
+  vkCmdPipelineBarrier2(cb, &dependency_info);
+}
+
+// Zeroes the DC of packed SH of a point, the first lane of the first f16vec4 of each channel.
+void ZeroShDc(uint16_t* sh, uint32_t packed_size) {
+  uint32_t dc_stride = packed_size / 3;
+  for (int c = 0; c < 3; ++c) sh[c * dc_stride * 4] = 0;
+}
+
+// One k-means update of codebook (codebook_size, packed_size) f16vec4 from samples of the same layout, assigned to
+// codewords by the high half of assignments[2 * i + 1]. Empty codewords are reseeded with a sample.
+void UpdateShCodebook(const uint16_t* samples, const uint32_t* assignments, uint32_t sample_count,
+                      uint32_t packed_size, uint32_t codebook_size, uint16_t* codebook) {
+  uint32_t dim = packed_size * 4;
+
+  // Counting sort of samples by codeword.
+  std::vector<uint32_t> offsets(codebook_size + 1, 0);
+  for (uint32_t i = 0; i < sample_count; ++i) offsets[(assignments[2 * i + 1] >> 16) + 1]++;
+  for (uint32_t k = 0; k < codebook_size; ++k) offsets[k + 1] += offsets[k];
+  std::vector<uint32_t> order(sample_count);
+  std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+  for (uint32_t i = 0; i < sample_count; ++i) order[next[assignments[2 * i + 1] >> 16]++] = i;
+
+  ParallelFor(codebook_size, [&](size_t k) {
+    uint16_t* code = codebook + k * dim;
+    uint32_t begin = offsets[k];
+    uint32_t end = offsets[k + 1];
+    if (begin == end) {
+      const uint16_t* sample = samples + k * 2654435761ull % sample_count * dim;
+      std::memcpy(code, sample, dim * sizeof(uint16_t));
+    } else {
+      std::vector<float> sum(dim, 0.f);
+      for (uint32_t j = begin; j < end; ++j) {
+        const uint16_t* sample = samples + static_cast<uint64_t>(order[j]) * dim;
+        for (uint32_t d = 0; d < dim; ++d) sum[d] += glm::unpackHalf1x16(sample[d]);
+      }
+      for (uint32_t d = 0; d < dim; ++d) code[d] = glm::packHalf1x16(sum[d] / (end - begin));
+    }
+    ZeroShDc(code, packed_size);
+  });
+}
+
+// A validated PLY file. For non-compressed files, the vertex body is ready to be copied or converted into parse
+// chunks.
+struct PlySource {
+  std::unique_ptr<MappedFile> file;
+  PlyHeader header;
+  bool compressed = false;
+
+  const PlyElement* vertex = nullptr;
+  PlyLayout layout = {};
+  std::unique_ptr<PlyAsciiReader> ascii;  // cursor of ASCII bodies, converted as chunks are filled
+  const char* body = nullptr;             // binary bodies
+  size_t body_offset = 0;
+  uint32_t point_count = 0;
+  uint32_t stride = 0;
+  int sh_degree = 0;
+  int sh_packed_size = 0;
+};
+
+// Point count of a PLY vertex element. Splats are indexed with 32 bits on the GPU.
+uint32_t PlyPointCount(const PlyElement& vertex, const std::string& path) {
+  if (vertex.count > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("PLY vertex element has more than 2^32 - 1 points: " + path);
+  }
+  return static_cast<uint32_t>(vertex.count);
+}
+
+void PreparePly(const std::string& path, int sh_degree, PlySource* source) {
+  source->file = std::make_unique<MappedFile>(path);
+  const auto& file = *source->file;
+  std::string_view contents(file.data(), file.size());
+
+  // parse header
+  source->header = ParsePlyHeader(contents, path);
+  const auto& header = source->header;
+  if (header.FindElement("chunk") != nullptr) {
+    source->compressed = true;
+    return;
+  }
+
+  const auto* vertex = header.FindElement("vertex");
+  if (vertex == nullptr || vertex->count == 0) {
+    throw std::runtime_error("PLY file has no vertex element: " + path);
+  }
+  if (vertex->has_list) {
+    throw std::runtime_error("PLY list properties are not supported in vertex element: " + path);
+  }
+  uint32_t point_count = PlyPointCount(*vertex, path);
+  uint32_t offset = vertex->stride;
+
+  std::string missing;
+  for (const char* name : {"x", "y", "z", "scale_0", "scale_1", "scale_2", "rot_0", "rot_1", "rot_2", "rot_3",
+                           "f_dc_0", "f_dc_1", "f_dc_2", "opacity"}) {
+    if (vertex->FindProperty(name) == nullptr) missing += std::string(missing.empty() ? "" : ", ") + name;
+  }
+  if (!missing.empty()) {
+    throw std::runtime_error("PLY vertex element is missing properties " + missing + ": " + path);
+  }
+
+  int K = 0;
+  for (const auto& property : vertex->properties) {
+    if (property.name.rfind("f_rest_", 0) == 0) K++;
+  }
+  for (int i = 0; i < K; ++i) {
+    if (vertex->FindProperty("f_rest_" + std::to_string(i)) == nullptr) {
+      throw std::runtime_error("PLY vertex element is missing property f_rest_" + std::to_string(i) + ": " + path);
+    }
+  }
+
+  int sh_degree_data = 0;  // [0, 1, 2, 3], sh degree
+  int sh_packed_size = 0;  // [1, 3, 7, 12], storage dimension for packing with f16vec4.
+  GetShLayout(K, &sh_degree_data, &sh_packed_size);
+  K /= 3;
+
+  if (sh_degree == -1) sh_degree = sh_degree_data;
+  if (sh_degree > sh_degree_data) {
+    throw std::runtime_error("SH degree for drawing is greater than the maximum degree of the data");
+  }
+
+  PlyLayout& ply_layout = source->layout;
+  auto set_property = [&](int index, const std::string& name) {
+    const auto* property = vertex->FindProperty(name);
+    ply_layout.offsets[index] = property->offset;
+    ply_layout.types[index] = static_cast<uint32_t>(property->type);
+    ply_layout.quant[index] = glm::vec2(property->scale, property->bias);
+  };
+  set_property(0, "x");
+  set_property(1, "y");
+  set_property(2, "z");
+  set_property(3, "scale_0");
+  set_property(4, "scale_1");
+  set_property(5, "scale_2");
+  set_property(6, "rot_1");  // qx
+  set_property(7, "rot_2");  // qy
+  set_property(8, "rot_3");  // qz
+  set_property(9, "rot_0");  // qw
+  set_property(10 + 0, "f_dc_0");
+  set_property(10 + 16, "f_dc_1");
+  set_property(10 + 32, "f_dc_2");
+  for (int i = 0; i < K; ++i) {
+    set_property(10 + 1 + i, "f_rest_" + std::to_string(K * 0 + i));
+    set_property(10 + 17 + i, "f_rest_" + std::to_string(K * 1 + i));
+    set_property(10 + 33 + i, "f_rest_" + std::to_string(K * 2 + i));
+  }
+  set_property(58, "opacity");
+  ply_layout.offsets[59] = offset;
+
+  // Binary bodies are copied from the mapping, ASCII bodies are converted to the little-endian binary layout chunk by
+  // chunk.
+  if (header.format == PlyFormat::kAscii) {
+    source->ascii = std::make_unique<PlyAsciiReader>(header, contents, "vertex");
+  } else {
+    source->body_offset = PlyElementOffset(header, "vertex");
+    size_t body_size = static_cast<size_t>(offset) * point_count;
+    if (source->body_offset + body_size > file.size()) {
+      throw std::runtime_error("PLY file is truncated: " + path);
+    }
+    source->body = file.data() + source->body_offset;
+  }
+
+  source->vertex = vertex;
+  source->point_count = point_count;
+  source->stride = offset;
+  source->sh_degree = sh_degree;
+  source->sh_packed_size = sh_packed_size;
+}
 
-Renderer::Renderer() {
-  device_ = std::make_shared<gpu::Device>();
+// Writes [PlyLayout, ply(n, M)] of points [point_offset, point_offset + point_count) to data. Returns the bytes
+// written. ASCII sources are read in order, so their chunks must be filled in increasing point_offset.
+uint64_t FillPly(PlySource& source, uint32_t point_offset, uint32_t point_count, char* data) {
+  size_t chunk_bytes = static_cast<size_t>(point_count) * source.stride;
+  size_t body_chunk_offset = static_cast<size_t>(point_offset) * source.stride;
+
+  char* chunk_data = data + sizeof(PlyLayout);
+  std::memcpy(data, &source.layout, sizeof(PlyLayout));
+  if (source.ascii) {
+    if (source.ascii->record() != point_offset) throw std::logic_error("ASCII PLY chunks filled out of order");
+    size_t position = source.ascii->position();
+    source.ascii->Read(point_count, chunk_data);
+    source.file->Release(position, source.ascii->position() - position);
+  } else {
+    std::memcpy(chunk_data, source.body + body_chunk_offset, chunk_bytes);
+    if (source.header.format == PlyFormat::kBinaryBigEndian) SwapPlyEndian(*source.vertex, chunk_data, point_count);
+    source.file->Release(source.body_offset + body_chunk_offset, chunk_bytes);
+  }
+  return sizeof(PlyLayout) + chunk_bytes;
+}
+
+// Extends [*min, *max] by the finite positions of a chunk filled by FillPly with point_count points.
+void ExtendPlyBounds(const char* data, uint32_t point_count, glm::vec3* min, glm::vec3* max) {
+  const auto& layout = *reinterpret_cast<const PlyLayout*>(data);
+  const char* records = data + sizeof(PlyLayout);
+  for (uint32_t i = 0; i < point_count; ++i) {
+    const char* record = records + static_cast<size_t>(layout.offsets[59]) * i;
+    glm::vec3 position;
+    for (int k = 0; k < 3; ++k) {
+      double raw = ReadPlyValue(record + layout.offsets[k], static_cast<PlyType>(layout.types[k]));
+      position[k] = static_cast<float>(raw * layout.quant[k].x + layout.quant[k].y);
+    }
+    if (!std::isfinite(position.x) || !std::isfinite(position.y) || !std::isfinite(position.z)) continue;
+    *min = glm::min(*min, position);
+    *max = glm::max(*max, position);
+  }
+}
+
+}  // namespace
+
+Renderer::Renderer() : Renderer(2) {}
+
+Renderer::Renderer(uint32_t frames_in_flight)
+    : Renderer(std::make_shared<ScratchPool>(std::make_shared<gpu::Device>()), frames_in_flight) {}
+
+Renderer::Renderer(std::shared_ptr<ScratchPool> scratch_pool, uint32_t frames_in_flight) {
+  if (frames_in_flight == 0) throw std::runtime_error("frames_in_flight must be at least 1");
+
+  scratch_pool_ = scratch_pool;
+  device_ = scratch_pool->device();
+  mutex_ = scratch_pool->queue_mutex();
   task_monitor_ = std::make_shared<gpu::TaskMonitor>();
+  residency_manager_ = std::make_shared<ResidencyManager>();
   sorter_ = std::make_shared<Sorter>(*device_, device_->physical_device());
-
-  for (int i = 0; i < 2; ++i) {
-    auto& double_buffer = double_buffer_[i];
-    double_buffer.compute_storage = std::make_shared<ComputeStorage>(device_);
-    double_buffer.graphics_storage = std::make_shared<GraphicsStorage>(device_);
-    double_buffer.transfer_storage = std::make_shared<TransferStorage>(device_);
-    double_buffer.compute_semaphore = device_->AllocateSemaphore();
-    double_buffer.graphics_semaphore = device_->AllocateSemaphore();
-    double_buffer.transfer_semaphore = device_->AllocateSemaphore();
+  upload_ring_ = std::make_shared<UploadRing>(device_, kUploadRingSizePerFrame * frames_in_flight);
+  staging_pool_ = std::make_shared<HostBufferPool>(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kMemoryTagStaging);
+  readback_pool_ = std::make_shared<HostBufferPool>(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT, kMemoryTagReadback);
+  gpu_timer_ = std::make_shared<GpuTimer>(device_);
+
+  frames_.resize(frames_in_flight);
+  for (auto& frame : frames_) {
+    frame.graphics_storage = std::make_shared<GraphicsStorage>(device_);
+    frame.transfer_storage = std::make_shared<TransferStorage>(device_);
+    frame.compute_semaphore = device_->AllocateSemaphore();
+    frame.graphics_semaphore = device_->AllocateSemaphore();
+    frame.transfer_semaphore = device_->AllocateSemaphore();
   }
 
   parse_pipeline_layout_ =
@@ -89,10 +516,19 @@ Renderer::Renderer() {
                                       {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
                                       {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
                                       {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+                                      {5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+                                      {6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
                                   },
                                   {{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ParsePushConstants)}});
   parse_ply_pipeline_ = gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, parse_ply);
+  parse_compressed_ply_pipeline_ =
+      gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, parse_compressed_ply);
   parse_data_pipeline_ = gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, parse_data);
+  quantize_pipeline_ = gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, quantize);
+  sh_codebook_pipeline_ = gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, sh_codebook);
+  interleave_pipeline_ = gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, interleave);
+  morton_bounds_pipeline_ = gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, morton_bounds);
+  morton_pipeline_ = gpu::ComputePipeline::Create(*device_, *parse_pipeline_layout_, morton);
 
   compute_pipeline_layout_ =
       gpu::PipelineLayout::Create(*device_,
@@ -106,21 +542,49 @@ Renderer::Renderer() {
                                       {6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
                                       {7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
                                       {8, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+                                      {9, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+                                      {10, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
                                   },
                                   {{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ComputePushConstants)}});
-  rank_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, rank);
+  // Rank compacts visible points with one atomic per subgroup where subgroup ballot is supported.
+  if (device_->subgroup_ballot()) {
+    rank_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, rank_subgroup);
+    rank_quantized_pipeline_ =
+        gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, rank_quantized_subgroup);
+    rank_interleaved_pipeline_ =
+        gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, rank_interleaved_subgroup);
+  } else {
+    rank_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, rank);
+    rank_quantized_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, rank_quantized);
+    rank_interleaved_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, rank_interleaved);
+  }
   inverse_index_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, inverse_index);
+  dispatch_indirect_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, dispatch_indirect);
   projection_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, projection);
+  projection_quantized_pipeline_ =
+      gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, projection_quantized);
+  projection_sh_codebook_pipeline_ =
+      gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, projection_sh_codebook);
+  projection_quantized_sh_codebook_pipeline_ =
+      gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, projection_quantized_sh_codebook);
+  projection_interleaved_pipeline_ =
+      gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, projection_interleaved);
+  projection_interleaved_sh_codebook_pipeline_ =
+      gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, projection_interleaved_sh_codebook);
+  reorder_pipeline_ = gpu::ComputePipeline::Create(*device_, *compute_pipeline_layout_, reorder);
 
   graphics_pipeline_layout_ =
       gpu::PipelineLayout::Create(*device_, {{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT}},
                                   {{VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(GraphicsPushConstants)}});
   // Create two pipelines: one with depth writing disabled (for transparency) and one with depth writing enabled (for auto-range)
   // Use LESS_OR_EQUAL for depth-write pipeline to allow more fragments to pass, helping with transparency
+  // Splats are drawn as one instance of a 4-vertex triangle strip each, without an index buffer.
   splat_pipeline_ = gpu::GraphicsPipeline::Create(*device_, *graphics_pipeline_layout_, splat_vert, splat_frag,
-                                                  VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, false, VK_COMPARE_OP_LESS);
+                                                  VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, false, VK_COMPARE_OP_LESS,
+                                                  VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP);
   splat_pipeline_depth_write_ = gpu::GraphicsPipeline::Create(*device_, *graphics_pipeline_layout_, splat_vert, splat_frag,
-                                                               VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, true, VK_COMPARE_OP_LESS_OR_EQUAL);
+                                                               VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, true, VK_COMPARE_OP_LESS_OR_EQUAL,
+                                                               VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP);
   splat_background_pipeline_ =
       gpu::GraphicsPipeline::Create(*device_, *graphics_pipeline_layout_, splat_background_vert, splat_background_frag,
                                     VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, false);
@@ -136,18 +600,7 @@ uint32_t Renderer::transfer_queue_index() const noexcept { return device_->trans
 std::shared_ptr<GaussianSplats> Renderer::CreateGaussianSplats(size_t size, const float* means_ptr,
                                                                const float* quats_ptr, const float* scales_ptr,
                                                                const float* opacities_ptr, const uint16_t* colors_ptr,
-                                                               int sh_degree) {
-  std::vector<uint32_t> index_data;
-  index_data.reserve(6 * size);
-  for (int i = 0; i < size; ++i) {
-    index_data.push_back(4 * i + 0);
-    index_data.push_back(4 * i + 1);
-    index_data.push_back(4 * i + 2);
-    index_data.push_back(4 * i + 2);
-    index_data.push_back(4 * i + 1);
-    index_data.push_back(4 * i + 3);
-  }
-
+                                                               int sh_degree, std::shared_ptr<void> owner) {
   int colors_size = 0;
   int sh_packed_size = 0;
   switch (sh_degree) {
@@ -171,37 +624,51 @@ std::shared_ptr<GaussianSplats> Renderer::CreateGaussianSplats(size_t size, cons
       throw std::runtime_error("Unsupported SH degree: " + std::to_string(sh_degree));
   }
 
-  auto position_stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size * 3 * sizeof(float), true);
-  auto quats_stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size * 4 * sizeof(float), true);
-  auto scales_stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size * 3 * sizeof(float), true);
-  auto colors_stage =
-      gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size * colors_size * 3 * sizeof(uint16_t), true);
-  auto opacity_stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size * sizeof(float), true);
-  auto index_stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size * 6 * sizeof(uint32_t), true);
-
-  auto position = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                                      size * 3 * sizeof(float));
+  auto position = gpu::Buffer::Create(device_, kSplatBufferUsage, size * 3 * sizeof(float));
   auto quats = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                                    size * 4 * sizeof(float));
   auto scales = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                                     size * 3 * sizeof(float));
   auto colors = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                                     size * colors_size * 3 * sizeof(uint16_t));
-  auto opacity = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                                     size * sizeof(float));
-
-  auto cov3d = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, size * 6 * sizeof(float));
-  auto sh =
-      gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, size * sh_packed_size * 4 * sizeof(uint16_t));
-  auto index_buffer = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                                          size * 6 * sizeof(uint32_t));
-
-  std::memcpy(position_stage->data(), means_ptr, position_stage->size());
-  std::memcpy(quats_stage->data(), quats_ptr, quats_stage->size());
-  std::memcpy(scales_stage->data(), scales_ptr, scales_stage->size());
-  std::memcpy(opacity_stage->data(), opacities_ptr, opacity_stage->size());
-  std::memcpy(colors_stage->data(), colors_ptr, colors_stage->size());
-  std::memcpy(index_stage->data(), index_data.data(), index_stage->size());
+  auto opacity = gpu::Buffer::Create(device_, kSplatBufferUsage, size * sizeof(float));
+
+  auto cov3d = gpu::Buffer::Create(device_, kSplatBufferUsage, size * 6 * sizeof(float));
+  auto sh = gpu::Buffer::Create(device_, kSplatBufferUsage, size * sh_packed_size * 4 * sizeof(uint16_t));
+
+  // Import the caller's arrays as transfer sources where possible, if the owner keeps them alive until the transfer is
+  // done. The rest are packed into one staging buffer from the pool.
+  struct Upload {
+    const void* src;
+    std::shared_ptr<gpu::Buffer> dst;
+    std::shared_ptr<gpu::Buffer> imported;
+    VkDeviceSize stage_offset = 0;
+  };
+  std::vector<Upload> uploads = {
+      {means_ptr, position}, {quats_ptr, quats}, {scales_ptr, scales}, {colors_ptr, colors}, {opacities_ptr, opacity},
+  };
+  VkDeviceSize stage_size = 0;
+  for (auto& upload : uploads) {
+    if (owner) {
+      upload.imported =
+          gpu::Buffer::Import(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, upload.src, upload.dst->size(), owner);
+    }
+    if (!upload.imported) {
+      upload.stage_offset = stage_size;
+      stage_size += (upload.dst->size() + 255) & ~VkDeviceSize(255);
+    }
+  }
+
+  std::shared_ptr<gpu::Buffer> stage;
+  if (stage_size > 0) {
+    {
+      std::lock_guard<std::mutex> lock(*mutex_);
+      stage = staging_pool_->Acquire(stage_size);
+    }
+    for (const auto& upload : uploads) {
+      if (!upload.imported) std::memcpy(stage->data<char>() + upload.stage_offset, upload.src, upload.dst->size());
+    }
+  }
 
   ParsePushConstants parse_data_push_constants = {};
   parse_data_push_constants.point_count = size;
@@ -210,12 +677,13 @@ std::shared_ptr<GaussianSplats> Renderer::CreateGaussianSplats(size_t size, cons
   auto sem = device_->AllocateSemaphore();
   auto tq = device_->transfer_queue();
   auto cq = device_->compute_queue();
-  auto gq = device_->graphics_queue();
 
+  std::shared_ptr<gpu::Task> transfer_task;
   std::shared_ptr<gpu::Task> task;
 
   // Transfer queue: stage to buffers
   {
+    std::lock_guard<std::mutex> lock(*mutex_);
     auto cb = tq->AllocateCommandBuffer();
     auto fence = device_->AllocateFence();
 
@@ -223,20 +691,17 @@ std::shared_ptr<GaussianSplats> Renderer::CreateGaussianSplats(size_t size, cons
     begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(*cb, &begin_info);
 
-    VkBufferCopy region = {0, 0, position_stage->size()};
-    vkCmdCopyBuffer(*cb, *position_stage, *position, 1, &region);
-    region = {0, 0, quats_stage->size()};
-    vkCmdCopyBuffer(*cb, *quats_stage, *quats, 1, &region);
-    region = {0, 0, scales_stage->size()};
-    vkCmdCopyBuffer(*cb, *scales_stage, *scales, 1, &region);
-    region = {0, 0, colors_stage->size()};
-    vkCmdCopyBuffer(*cb, *colors_stage, *colors, 1, &region);
-    region = {0, 0, opacity_stage->size()};
-    vkCmdCopyBuffer(*cb, *opacity_stage, *opacity, 1, &region);
-    region = {0, 0, index_stage->size()};
-    vkCmdCopyBuffer(*cb, *index_stage, *index_buffer, 1, &region);
-
-    std::vector<VkBufferMemoryBarrier2> release_barriers(6);
+    for (const auto& upload : uploads) {
+      if (upload.imported) {
+        VkBufferCopy region = {upload.imported->offset(), 0, upload.dst->size()};
+        vkCmdCopyBuffer(*cb, *upload.imported, *upload.dst, 1, &region);
+      } else {
+        VkBufferCopy region = {upload.stage_offset, 0, upload.dst->size()};
+        vkCmdCopyBuffer(*cb, *stage, *upload.dst, 1, &region);
+      }
+    }
+
+    std::vector<VkBufferMemoryBarrier2> release_barriers(5);
     release_barriers[0] = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
     release_barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
     release_barriers[0].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
@@ -277,14 +742,6 @@ std::shared_ptr<GaussianSplats> Renderer::CreateGaussianSplats(size_t size, cons
     release_barriers[4].buffer = *opacity;
     release_barriers[4].offset = 0;
     release_barriers[4].size = VK_WHOLE_SIZE;
-    release_barriers[5] = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
-    release_barriers[5].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    release_barriers[5].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    release_barriers[5].srcQueueFamilyIndex = tq->family_index();
-    release_barriers[5].dstQueueFamilyIndex = gq->family_index();
-    release_barriers[5].buffer = *index_buffer;
-    release_barriers[5].offset = 0;
-    release_barriers[5].size = VK_WHOLE_SIZE;
     VkDependencyInfo release_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
     release_dependency_info.bufferMemoryBarrierCount = release_barriers.size();
     release_dependency_info.pBufferMemoryBarriers = release_barriers.data();
@@ -307,12 +764,18 @@ std::shared_ptr<GaussianSplats> Renderer::CreateGaussianSplats(size_t size, cons
     submit.pSignalSemaphoreInfos = &signal_semaphore_info;
 
     vkQueueSubmit2(*tq, 1, &submit, *fence);
-    task_monitor_->Add(fence, {cb, position_stage, quats_stage, scales_stage, colors_stage, opacity_stage, index_stage,
-                               position, quats, scales, colors, opacity, index_buffer});
+    std::vector<std::shared_ptr<gpu::Object>> objects = {cb, position, quats, scales, colors, opacity};
+    if (stage) objects.push_back(stage);
+    for (const auto& upload : uploads) {
+      if (upload.imported) objects.push_back(upload.imported);
+    }
+    transfer_task = task_monitor_->Add(fence, objects);
+    if (stage) staging_pool_->Release(stage, transfer_task);
   }
 
   // Compute queue: parse data
   {
+    std::lock_guard<std::mutex> lock(*mutex_);
     auto cb = cq->AllocateCommandBuffer();
     auto fence = device_->AllocateFence();
 
@@ -402,252 +865,968 @@ std::shared_ptr<GaussianSplats> Renderer::CreateGaussianSplats(size_t size, cons
     task = task_monitor_->Add(fence, {cb, sem, position, quats, scales, cov3d, colors, sh, opacity});
   }
 
-  // Graphics queue: make visible
-  {
-    auto cb = gq->AllocateCommandBuffer();
-    auto fence = device_->AllocateFence();
+  sem->Increment();
 
-    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(*cb, &begin_info);
+  return Track(std::make_shared<GaussianSplats>(size, sh_degree, position, cov3d, sh, opacity, task));
+}
 
-    VkBufferMemoryBarrier2 acquire_barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
-    acquire_barrier.dstStageMask = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
-    acquire_barrier.dstAccessMask = VK_ACCESS_2_INDEX_READ_BIT;
-    acquire_barrier.srcQueueFamilyIndex = tq->family_index();
-    acquire_barrier.dstQueueFamilyIndex = gq->family_index();
-    acquire_barrier.buffer = *index_buffer;
-    acquire_barrier.offset = 0;
-    acquire_barrier.size = VK_WHOLE_SIZE;
-    VkDependencyInfo acquire_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    acquire_dependency_info.bufferMemoryBarrierCount = 1;
-    acquire_dependency_info.pBufferMemoryBarriers = &acquire_barrier;
-    vkCmdPipelineBarrier2(*cb, &acquire_dependency_info);
+std::shared_ptr<GaussianSplats> Renderer::LoadFromPly(const std::string& path, int sh_degree) {
+  return LoadFromPly(path, sh_degree, nullptr);
+}
 
-    vkEndCommandBuffer(*cb);
+std::shared_ptr<LoadTask> Renderer::LoadFromPlyAsync(const std::string& path, const LoadOptions& options) {
+  auto task = std::make_shared<LoadTask>();
+  task->Start([this, path, options](LoadTask* load_task) {
+    auto splats = LoadFromPly(path, options.sh_degree, load_task);
+    if (options.reorder) splats = Reorder(splats);
+    if (options.interleave) splats = Interleave(splats);
+    if (options.quantize) splats = Quantize(splats);
+    if (options.sh_codebook_size > 0) splats = CompressSh(splats, options.sh_codebook_size);
+    return splats;
+  });
+  return task;
+}
 
-    VkSemaphoreSubmitInfo wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
-    wait_semaphore_info.semaphore = *sem;
-    wait_semaphore_info.value = sem->value() + 1;
-    wait_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+std::shared_ptr<GaussianSplats> Renderer::LoadFromPly(const std::string& path, int sh_degree, LoadTask* task) {
+  PlySource source;
+  PreparePly(path, sh_degree, &source);
+  if (source.compressed) return LoadFromCompressedPly(*source.file, source.header, path, sh_degree, task);
 
-    VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
-    command_buffer_info.commandBuffer = *cb;
+  bool ascii = source.header.format == PlyFormat::kAscii;
+  uint32_t point_count = source.point_count;
+  uint32_t offset = source.stride;
 
-    VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
-    submit.commandBufferInfoCount = 1;
-    submit.pCommandBufferInfos = &command_buffer_info;
-    submit.waitSemaphoreInfoCount = 1;
-    submit.pWaitSemaphoreInfos = &wait_semaphore_info;
-    vkQueueSubmit2(*gq, 1, &submit, *fence);
-    task_monitor_->Add(fence, {cb, sem, index_buffer});
+  // Bodies are read as chunks are filled, ASCII ones up to the end of the last converted token.
+  if (task) {
+    task->SetTotal(source.file->size(), point_count);
+    task->AddProgress(ascii ? source.ascii->position() : source.body_offset, 0);
   }
 
-  sem->Increment();
-
-  return std::make_shared<GaussianSplats>(size, sh_degree, position, cov3d, sh, opacity, index_buffer, task);
+  // The vertex body is streamed in chunks of whole points, each [PlyLayout, ply(n, M)].
+  uint32_t chunk_point_count = std::max<size_t>(kStagingChunkSize / offset, 1);
+  uint32_t chunk_count = WorkgroupSize(point_count, chunk_point_count);
+  // Padded by a word since the shader reads properties at unaligned byte offsets as two words.
+  VkDeviceSize chunk_buffer_size =
+      sizeof(PlyLayout) + static_cast<VkDeviceSize>(chunk_point_count) * offset + sizeof(uint32_t);
+
+  // Position bounds for the task are gathered from the decoded chunks, so they cover every format and type.
+  glm::vec3 bounds_min(std::numeric_limits<float>::max());
+  glm::vec3 bounds_max(std::numeric_limits<float>::lowest());
+
+  auto fill = [&](uint32_t chunk, char* data) {
+    ParseChunk parse_chunk;
+    parse_chunk.point_offset = chunk * chunk_point_count;
+    parse_chunk.point_count = std::min(chunk_point_count, point_count - parse_chunk.point_offset);
+    size_t ascii_position = ascii ? source.ascii->position() : 0;
+    parse_chunk.size = FillPly(source, parse_chunk.point_offset, parse_chunk.point_count, data);
+    parse_chunk.read_size = ascii ? source.ascii->position() - ascii_position : parse_chunk.size - sizeof(PlyLayout);
+    if (task) ExtendPlyBounds(data, parse_chunk.point_count, &bounds_min, &bounds_max);
+    return parse_chunk;
+  };
+
+  auto splats = ParseChunked(point_count, source.sh_degree, source.sh_packed_size, chunk_count, chunk_buffer_size,
+                             parse_ply_pipeline_, fill, task);
+  if (task && bounds_min.x <= bounds_max.x) task->SetBounds(bounds_min, bounds_max);
+  return splats;
 }
 
-std::shared_ptr<GaussianSplats> Renderer::LoadFromPly(const std::string& path, int sh_degree) {
-  std::ifstream in(path, std::ios::binary);
-
-  // parse header
-  std::unordered_map<std::string, int> offsets;
-  int offset = 0;
-  uint32_t point_count = 0;
-  std::string line;
-  while (std::getline(in, line)) {
-    if (line == "end_header") break;
-
-    std::istringstream iss(line);
-    std::string word;
-    iss >> word;
-    if (word == "property") {
-      int size = 0;
-      std::string type, property;
-      iss >> type >> property;
-      if (type == "float") {
-        size = 4;
+std::vector<std::shared_ptr<GaussianSplats>> Renderer::LoadManyFromPly(const std::vector<std::string>& paths,
+                                                                       int sh_degree) {
+  // Headers are parsed in parallel. ASCII bodies are converted as their chunks are filled.
+  std::vector<PlySource> sources(paths.size());
+  ParallelFor(paths.size(), [&](size_t i) { PreparePly(paths[i], sh_degree, &sources[i]); });
+
+  // Vertex bodies of all files are packed into shared staging chunks. A file may span several chunks.
+  std::vector<ParseTarget> targets;
+  std::vector<size_t> target_sources;
+  std::vector<std::vector<ParseChunk>> chunks;
+  uint64_t chunk_used = 0;
+  uint64_t chunk_buffer_size = 0;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    const auto& source = sources[i];
+    if (source.compressed) continue;
+
+    uint32_t target = targets.size();
+    targets.push_back({source.point_count, static_cast<uint32_t>(source.sh_degree),
+                       static_cast<uint32_t>(source.sh_packed_size), parse_ply_pipeline_});
+    target_sources.push_back(i);
+
+    for (uint32_t point_offset = 0; point_offset < source.point_count;) {
+      uint64_t available = 0;
+      if (!chunks.empty() && chunk_used + sizeof(PlyLayout) < kStagingChunkSize) {
+        available = (kStagingChunkSize - chunk_used - sizeof(PlyLayout)) / source.stride;
       }
-      offsets[property] = offset;
-      offset += size;
-    } else if (word == "element") {
-      std::string type;
-      size_t count;
-      iss >> type >> count;
-      if (type == "vertex") {
-        point_count = count;
+      if (available == 0) {
+        chunks.emplace_back();
+        chunk_used = 0;
+        available = std::max<uint64_t>((kStagingChunkSize - sizeof(PlyLayout)) / source.stride, 1);
       }
+
+      ParseChunk parse_chunk;
+      parse_chunk.target = target;
+      parse_chunk.offset = chunk_used;
+      parse_chunk.point_offset = point_offset;
+      parse_chunk.point_count = std::min<uint64_t>(available, source.point_count - point_offset);
+      parse_chunk.size = sizeof(PlyLayout) + static_cast<uint64_t>(parse_chunk.point_count) * source.stride;
+      parse_chunk.read_size = source.header.format == PlyFormat::kAscii ? 0 : parse_chunk.size - sizeof(PlyLayout);
+      chunks.back().push_back(parse_chunk);
+
+      chunk_buffer_size = std::max(chunk_buffer_size, parse_chunk.offset + parse_chunk.size);
+      chunk_used = (parse_chunk.offset + parse_chunk.size + kParseChunkAlignment - 1) / kParseChunkAlignment *
+                   kParseChunkAlignment;
+      point_offset += parse_chunk.point_count;
     }
   }
+  // Padded by a word since the shader reads properties at unaligned byte offsets as two words.
+  chunk_buffer_size += sizeof(uint32_t);
+
+  // Pieces of a chunk are filled in parallel, so files are read concurrently.
+  auto fill = [&](uint32_t chunk, char* data) {
+    const auto& parse_chunks = chunks[chunk];
+    ParallelFor(parse_chunks.size(), [&](size_t i) {
+      const auto& parse_chunk = parse_chunks[i];
+      FillPly(sources[target_sources[parse_chunk.target]], parse_chunk.point_offset, parse_chunk.point_count,
+              data + parse_chunk.offset);
+    });
+    return parse_chunks;
+  };
 
-  int K = 0;
-  for (const auto& [key, _] : offsets) {
-    if (key.find("f_rest_") != std::string::npos) {
-      K = std::max(K, std::stoi(key.substr(7)));
+  std::vector<std::shared_ptr<GaussianSplats>> result(paths.size());
+  if (!targets.empty()) {
+    auto splats = ParseChunked(targets, chunks.size(), chunk_buffer_size, fill, nullptr);
+    for (size_t i = 0; i < splats.size(); ++i) result[target_sources[i]] = splats[i];
+  }
+
+  // Compressed files carry per-chunk quantization and go through their own path.
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (sources[i].compressed) {
+      result[i] = LoadFromCompressedPly(*sources[i].file, sources[i].header, paths[i], sh_degree, nullptr);
     }
   }
-  K = K + 1;
 
-  int sh_degree_data = 0;  // [0, 1, 2, 3], sh degree
-  int sh_packed_size = 0;  // [1, 3, 7, 12], storage dimension for packing with f16vec4.
-  switch (K) {
-    case 0:  // no f_rest
-      sh_degree_data = 0;
-      sh_packed_size = 1;
-      break;
-    case 9:  // f_rest_[0..9)
-      sh_degree_data = 1;
-      sh_packed_size = 3;
-      break;
-    case 24:  // f_rest_[0..24)
-      sh_degree_data = 2;
-      sh_packed_size = 7;
-      break;
-    case 45:  // f_rest_[0..45)
-      sh_degree_data = 3;
-      sh_packed_size = 12;
-      break;
-    default:
-      throw std::runtime_error("Unsupported SH degree for having f_rest_[0.." + std::to_string(K - 1) + "]");
+  return result;
+}
+
+std::shared_ptr<GaussianSplats> Renderer::LoadFromCompressedPly(MappedFile& file, const PlyHeader& header,
+                                                                const std::string& path, int sh_degree,
+                                                                LoadTask* task) {
+  if (header.format != PlyFormat::kBinaryLittleEndian) {
+    throw std::runtime_error("Compressed PLY must be binary_little_endian: " + path);
+  }
+
+  const auto* chunk = header.FindElement("chunk");
+  const auto* vertex = header.FindElement("vertex");
+  const auto* sh_element = header.FindElement("sh");  // optional
+  if (vertex == nullptr || vertex->count == 0) {
+    throw std::runtime_error("PLY file has no vertex element: " + path);
+  }
+  uint32_t point_count = PlyPointCount(*vertex, path);
+
+  // Packed vertices are uploaded as is, so the layout must match exactly.
+  static const char* vertex_properties[] = {"packed_position", "packed_rotation", "packed_scale", "packed_color"};
+  bool valid_vertex = vertex->properties.size() == 4;
+  for (int i = 0; valid_vertex && i < 4; ++i) {
+    valid_vertex = vertex->properties[i].name == vertex_properties[i] && vertex->properties[i].type == PlyType::kUint;
+  }
+  if (!valid_vertex) {
+    throw std::runtime_error("Unsupported compressed PLY vertex layout: " + path);
+  }
+
+  // Chunk bounds. Color bounds are optional, defaulting to [0, 1].
+  static const char* chunk_properties[] = {
+      "min_x",       "min_y",       "min_z",       "max_x",       "max_y",       "max_z",
+      "min_scale_x", "min_scale_y", "min_scale_z", "max_scale_x", "max_scale_y", "max_scale_z",
+      "min_r",       "min_g",       "min_b",       "max_r",       "max_g",       "max_b",
+  };
+  uint32_t chunk_count = WorkgroupSize(point_count, kCompressedPlyChunkSize);
+  if (chunk->count != chunk_count || chunk->has_list) {
+    throw std::runtime_error("Invalid compressed PLY chunk element: " + path);
+  }
+  std::array<const PlyProperty*, 18> bound_properties;
+  for (int i = 0; i < 18; ++i) {
+    bound_properties[i] = chunk->FindProperty(chunk_properties[i]);
+    if (bound_properties[i] != nullptr && bound_properties[i]->type != PlyType::kFloat) {
+      throw std::runtime_error("Invalid compressed PLY chunk element: " + path);
+    }
+    if (bound_properties[i] == nullptr && i < 12) {
+      throw std::runtime_error("Compressed PLY chunk element is missing property " + std::string(chunk_properties[i]) +
+                               ": " + path);
+    }
+  }
+
+  // 8-bit SH, f_rest_[0..K)
+  uint32_t sh_stride = 0;
+  if (sh_element != nullptr) {
+    sh_stride = sh_element->properties.size();
+    if (sh_element->count != point_count || sh_element->has_list) {
+      throw std::runtime_error("Invalid compressed PLY sh element: " + path);
+    }
+    for (uint32_t i = 0; i < sh_stride; ++i) {
+      const auto& property = sh_element->properties[i];
+      if (property.name != "f_rest_" + std::to_string(i) || property.type != PlyType::kUchar) {
+        throw std::runtime_error("Unsupported compressed PLY sh layout: " + path);
+      }
+    }
   }
-  K /= 3;
+
+  int sh_degree_data = 0;
+  int sh_packed_size = 0;
+  GetShLayout(sh_stride, &sh_degree_data, &sh_packed_size);
 
   if (sh_degree == -1) sh_degree = sh_degree_data;
   if (sh_degree > sh_degree_data) {
     throw std::runtime_error("SH degree for drawing is greater than the maximum degree of the data");
   }
 
-  std::vector<uint32_t> ply_offsets(60);
-  ply_offsets[0] = offsets["x"] / 4;
-  ply_offsets[1] = offsets["y"] / 4;
-  ply_offsets[2] = offsets["z"] / 4;
-  ply_offsets[3] = offsets["scale_0"] / 4;
-  ply_offsets[4] = offsets["scale_1"] / 4;
-  ply_offsets[5] = offsets["scale_2"] / 4;
-  ply_offsets[6] = offsets["rot_1"] / 4;  // qx
-  ply_offsets[7] = offsets["rot_2"] / 4;  // qy
-  ply_offsets[8] = offsets["rot_3"] / 4;  // qz
-  ply_offsets[9] = offsets["rot_0"] / 4;  // qw
-  ply_offsets[10 + 0] = offsets["f_dc_0"] / 4;
-  ply_offsets[10 + 16] = offsets["f_dc_1"] / 4;
-  ply_offsets[10 + 32] = offsets["f_dc_2"] / 4;
-  for (int i = 0; i < K; ++i) {
-    ply_offsets[10 + 1 + i] = offsets["f_rest_" + std::to_string(K * 0 + i)] / 4;
-    ply_offsets[10 + 17 + i] = offsets["f_rest_" + std::to_string(K * 1 + i)] / 4;
-    ply_offsets[10 + 33 + i] = offsets["f_rest_" + std::to_string(K * 2 + i)] / 4;
+  size_t chunk_offset = PlyElementOffset(header, "chunk");
+  size_t vertex_offset = PlyElementOffset(header, "vertex");
+  size_t sh_offset = sh_element != nullptr ? PlyElementOffset(header, "sh") : 0;
+  size_t end = std::max({chunk_offset + static_cast<size_t>(chunk->stride) * chunk_count,
+                         vertex_offset + static_cast<size_t>(vertex->stride) * point_count,
+                         sh_offset + static_cast<size_t>(sh_stride) * point_count});
+  if (end > file.size()) {
+    throw std::runtime_error("PLY file is truncated: " + path);
   }
-  ply_offsets[58] = offsets["opacity"] / 4;
-  ply_offsets[59] = offset / 4;
 
-  std::vector<char> buffer(offset * point_count);
-  in.read(buffer.data(), buffer.size());
+  // Bounds are small, (point_count / 256, 18) floats; gather them once into a fixed layout.
+  std::vector<float> bounds(18 * chunk_count);
+  for (uint32_t i = 0; i < chunk_count; ++i) {
+    const char* record = file.data() + chunk_offset + static_cast<size_t>(chunk->stride) * i;
+    for (int j = 0; j < 18; ++j) {
+      if (bound_properties[j] != nullptr) {
+        std::memcpy(&bounds[18 * i + j], record + bound_properties[j]->offset, sizeof(float));
+      } else {
+        bounds[18 * i + j] = j < 15 ? 0.f : 1.f;
+      }
+    }
+  }
 
-  std::vector<uint32_t> index_data;
-  index_data.reserve(6 * point_count);
-  for (int i = 0; i < point_count; ++i) {
-    index_data.push_back(4 * i + 0);
-    index_data.push_back(4 * i + 1);
-    index_data.push_back(4 * i + 2);
-    index_data.push_back(4 * i + 2);
-    index_data.push_back(4 * i + 1);
-    index_data.push_back(4 * i + 3);
+  if (task) {
+    task->SetTotal(file.size(), point_count);
+    task->AddProgress(file.size() - (static_cast<size_t>(vertex->stride) + sh_stride) * point_count, 0);
   }
 
-  ParsePushConstants parse_ply_push_constants = {};
-  parse_ply_push_constants.point_count = point_count;
-  parse_ply_push_constants.sh_degree = sh_degree;
+  // Stream whole chunks of 256 points, each [CompressedPlyLayout, bounds(c, 18), vertices(n, 4), sh(n, K)].
+  size_t point_size = 4 * sizeof(uint32_t) + sh_stride;
+  uint32_t chunk_point_count =
+      std::max<size_t>(kStagingChunkSize / point_size / kCompressedPlyChunkSize, 1) * kCompressedPlyChunkSize;
+  uint32_t stream_chunk_count = WorkgroupSize(point_count, chunk_point_count);
+  auto words = [](size_t size) { return static_cast<uint32_t>((size + sizeof(uint32_t) - 1) / sizeof(uint32_t)); };
+  uint64_t chunk_buffer_size =
+      sizeof(CompressedPlyLayout) +
+      sizeof(uint32_t) * (18 * (chunk_point_count / kCompressedPlyChunkSize) + 4 * chunk_point_count +
+                          words(static_cast<size_t>(sh_stride) * chunk_point_count));
+
+  auto fill = [&](uint32_t stream_chunk, char* data) {
+    ParseChunk parse_chunk;
+    parse_chunk.point_offset = stream_chunk * chunk_point_count;
+    parse_chunk.point_count = std::min(chunk_point_count, point_count - parse_chunk.point_offset);
+    uint32_t first_bound = parse_chunk.point_offset / kCompressedPlyChunkSize;
+    uint32_t bound_count = (parse_chunk.point_count + kCompressedPlyChunkSize - 1) / kCompressedPlyChunkSize;
+
+    CompressedPlyLayout layout = {};
+    layout.vertex_offset = 18 * bound_count;
+    layout.sh_offset = layout.vertex_offset + 4 * parse_chunk.point_count;
+    layout.sh_stride = sh_stride;
+    std::memcpy(data, &layout, sizeof(layout));
+
+    uint32_t* words_data = reinterpret_cast<uint32_t*>(data + sizeof(layout));
+    std::memcpy(words_data, bounds.data() + 18 * first_bound, 18 * bound_count * sizeof(float));
+
+    size_t vertex_bytes = static_cast<size_t>(vertex->stride) * parse_chunk.point_count;
+    size_t vertex_chunk_offset = vertex_offset + static_cast<size_t>(vertex->stride) * parse_chunk.point_offset;
+    std::memcpy(words_data + layout.vertex_offset, file.data() + vertex_chunk_offset, vertex_bytes);
+    file.Release(vertex_chunk_offset, vertex_bytes);
+
+    size_t sh_bytes = static_cast<size_t>(sh_stride) * parse_chunk.point_count;
+    size_t sh_chunk_offset = sh_offset + static_cast<size_t>(sh_stride) * parse_chunk.point_offset;
+    if (sh_bytes > 0) {
+      std::memcpy(words_data + layout.sh_offset, file.data() + sh_chunk_offset, sh_bytes);
+      file.Release(sh_chunk_offset, sh_bytes);
+    }
 
+    parse_chunk.size = sizeof(layout) + sizeof(uint32_t) * (layout.sh_offset + words(sh_bytes));
+    parse_chunk.read_size = vertex_bytes + sh_bytes;
+    return parse_chunk;
+  };
+
+  auto splats = ParseChunked(point_count, sh_degree, sh_packed_size, stream_chunk_count, chunk_buffer_size,
+                             parse_compressed_ply_pipeline_, fill, task);
+
+  // Positions are quantized within the chunk bounds, so their union bounds the splats.
+  if (task) {
+    glm::vec3 bounds_min(std::numeric_limits<float>::max());
+    glm::vec3 bounds_max(std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < chunk_count; ++i) {
+      const float* chunk_bounds = bounds.data() + 18 * i;
+      glm::vec3 chunk_min(chunk_bounds[0], chunk_bounds[1], chunk_bounds[2]);
+      glm::vec3 chunk_max(chunk_bounds[3], chunk_bounds[4], chunk_bounds[5]);
+      if (!std::isfinite(chunk_min.x + chunk_min.y + chunk_min.z + chunk_max.x + chunk_max.y + chunk_max.z)) continue;
+      bounds_min = glm::min(bounds_min, chunk_min);
+      bounds_max = glm::max(bounds_max, chunk_max);
+    }
+    if (bounds_min.x <= bounds_max.x) task->SetBounds(bounds_min, bounds_max);
+  }
+  return splats;
+}
+
+std::shared_ptr<GaussianSplats> Renderer::ParseChunked(uint32_t point_count, uint32_t sh_degree,
+                                                       uint32_t sh_packed_size, uint32_t chunk_count,
+                                                       uint64_t chunk_buffer_size,
+                                                       std::shared_ptr<gpu::ComputePipeline> pipeline,
+                                                       const std::function<ParseChunk(uint32_t, char*)>& fill,
+                                                       LoadTask* task) {
+  return ParseChunked({{point_count, sh_degree, sh_packed_size, pipeline}}, chunk_count, chunk_buffer_size,
+                      [&](uint32_t chunk, char* data) { return std::vector<ParseChunk>{fill(chunk, data)}; }, task)[0];
+}
+
+std::vector<std::shared_ptr<GaussianSplats>> Renderer::ParseChunked(
+    const std::vector<ParseTarget>& targets, uint32_t chunk_count, uint64_t chunk_buffer_size,
+    const std::function<std::vector<ParseChunk>(uint32_t, char*)>& fill, LoadTask* task) {
   // allocate buffers
-  auto buffer_size = buffer.size() + 60 * sizeof(uint32_t);
-  auto ply_stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                                       buffer_size, true);
-  auto ply_buffer =
-      gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, buffer_size);
-
-  auto position = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * 3 * sizeof(float));
-  auto cov3d = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * 6 * sizeof(float));
-  auto sh = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                                point_count * sh_packed_size * 4 * sizeof(uint16_t));
-  auto opacity = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * sizeof(float));
-
-  auto index_stage =
-      gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, point_count * 6 * sizeof(uint32_t), true);
-  auto index_buffer = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                                          point_count * 6 * sizeof(uint32_t));
-
-  std::memcpy(ply_stage->data(), ply_offsets.data(), ply_offsets.size() * sizeof(uint32_t));
-  std::memcpy(ply_stage->data<char>() + ply_offsets.size() * sizeof(uint32_t), buffer.data(), buffer.size());
-  std::memcpy(index_stage->data(), index_data.data(), index_data.size() * sizeof(uint32_t));
+  struct TargetBuffers {
+    std::shared_ptr<gpu::Buffer> position;
+    std::shared_ptr<gpu::Buffer> cov3d;
+    std::shared_ptr<gpu::Buffer> sh;
+    std::shared_ptr<gpu::Buffer> opacity;
+    std::shared_ptr<gpu::Task> task;  // parse of the last chunk with points of the target
+  };
+  std::vector<TargetBuffers> outputs(targets.size());
+  for (size_t i = 0; i < targets.size(); ++i) {
+    const auto& target = targets[i];
+    auto& output = outputs[i];
+    output.position = gpu::Buffer::Create(device_, kSplatBufferUsage, target.point_count * 3 * sizeof(float));
+    output.cov3d = gpu::Buffer::Create(device_, kSplatBufferUsage, target.point_count * 6 * sizeof(float));
+    output.sh = gpu::Buffer::Create(device_, kSplatBufferUsage,
+                                    target.point_count * target.sh_packed_size * 4 * sizeof(uint16_t));
+    output.opacity = gpu::Buffer::Create(device_, kSplatBufferUsage, target.point_count * sizeof(float));
+  }
 
-  auto sem = device_->AllocateSemaphore();
+  // Chunks go through a small ring of staging buffers. Each chunk is copied on the transfer queue and parsed on the
+  // compute queue, so filling chunk k+1 on the host overlaps with the copy and parse of chunk k.
+  uint32_t ring_size = std::min(kStagingRingSize, chunk_count);
+
+  struct StagingSlot {
+    std::shared_ptr<gpu::Buffer> stage;
+    std::shared_ptr<gpu::Buffer> buffer;
+    std::shared_ptr<gpu::Task> task;
+  };
+  std::vector<StagingSlot> slots(ring_size);
+  for (auto& slot : slots) {
+    slot.stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, chunk_buffer_size, true);
+    slot.stage->set_tag(kMemoryTagStaging);
+    slot.buffer = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                      chunk_buffer_size);
+    slot.buffer->set_tag(kMemoryTagStaging);
+  }
+
+  // tsem: chunk k copied, csem: chunk k parsed.
+  auto tsem = device_->AllocateSemaphore();
+  auto csem = device_->AllocateSemaphore();
+  auto tval = tsem->value();
+  auto cval = csem->value();
 
   auto cq = device_->compute_queue();
-  auto gq = device_->graphics_queue();
   auto tq = device_->transfer_queue();
 
-  std::shared_ptr<gpu::Task> task;
+  // Chunks are submitted in order, so stopping early leaves the semaphores at the last submitted chunk.
+  uint32_t chunk = 0;
+  for (; chunk < chunk_count; ++chunk) {
+    if (task && task->cancelled()) break;
 
-  // Transfer queue: stage to buffers
+    auto& slot = slots[chunk % ring_size];
+
+    // Wait until the previous copy from this staging buffer is done before overwriting it.
+    if (slot.task) {
+      slot.task->Wait();
+      slot.task = nullptr;
+    }
+
+    // A fill error, such as a malformed ASCII value, stops the load at this chunk like a cancel.
+    std::vector<ParseChunk> parse_chunks;
+    try {
+      parse_chunks = fill(chunk, slot.stage->data<char>());
+    } catch (...) {
+      tsem->SetValue(tval + chunk);
+      csem->SetValue(cval + chunk);
+      throw;
+    }
+    uint64_t chunk_size = 0;
+    for (const auto& parse_chunk : parse_chunks) {
+      chunk_size = std::max(chunk_size, parse_chunk.offset + parse_chunk.size);
+    }
+
+    // Transfer queue: stage to chunk buffer
+    {
+      std::lock_guard<std::mutex> lock(*mutex_);
+      auto cb = tq->AllocateCommandBuffer();
+      auto fence = device_->AllocateFence();
+
+      VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+      begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+      vkBeginCommandBuffer(*cb, &begin_info);
+
+      VkBufferCopy region = {0, 0, chunk_size};
+      vkCmdCopyBuffer(*cb, *slot.stage, *slot.buffer, 1, &region);
+
+      // Release barrier
+      std::vector<VkBufferMemoryBarrier2> release_barriers(1);
+      release_barriers[0] = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
+      release_barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+      release_barriers[0].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+      release_barriers[0].srcQueueFamilyIndex = tq->family_index();
+      release_barriers[0].dstQueueFamilyIndex = cq->family_index();
+      release_barriers[0].buffer = *slot.buffer;
+      release_barriers[0].offset = 0;
+      release_barriers[0].size = VK_WHOLE_SIZE;
+
+      VkDependencyInfo release_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+      release_dependency_info.bufferMemoryBarrierCount = release_barriers.size();
+      release_dependency_info.pBufferMemoryBarriers = release_barriers.data();
+      vkCmdPipelineBarrier2(*cb, &release_dependency_info);
+
+      vkEndCommandBuffer(*cb);
+
+      // Submit
+      std::vector<VkSemaphoreSubmitInfo> wait_semaphore_infos;
+      if (chunk >= ring_size) {
+        // C[k-R].parse before T[k].xfer, the chunk buffer is being reused.
+        auto& wait_semaphore_info = wait_semaphore_infos.emplace_back();
+        wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+        wait_semaphore_info.semaphore = *csem;
+        wait_semaphore_info.value = cval + chunk - ring_size + 1;
+        wait_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+      }
+
+      VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+      command_buffer_info.commandBuffer = *cb;
+
+      VkSemaphoreSubmitInfo signal_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      signal_semaphore_info.semaphore = *tsem;
+      signal_semaphore_info.value = tval + chunk + 1;
+      signal_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+
+      VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+      submit.waitSemaphoreInfoCount = wait_semaphore_infos.size();
+      submit.pWaitSemaphoreInfos = wait_semaphore_infos.data();
+      submit.commandBufferInfoCount = 1;
+      submit.pCommandBufferInfos = &command_buffer_info;
+      submit.signalSemaphoreInfoCount = 1;
+      submit.pSignalSemaphoreInfos = &signal_semaphore_info;
+
+      vkQueueSubmit2(*tq, 1, &submit, *fence);
+      slot.task = task_monitor_->Add(fence, {cb, tsem, csem, slot.stage, slot.buffer});
+    }
+
+    // Compute queue: parse chunk
+    {
+      std::lock_guard<std::mutex> lock(*mutex_);
+      auto cb = cq->AllocateCommandBuffer();
+      auto fence = device_->AllocateFence();
+
+      VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+      begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+      vkBeginCommandBuffer(*cb, &begin_info);
+
+      // Acquire barrier
+      VkBufferMemoryBarrier2 acquire_barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
+      acquire_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+      acquire_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+      acquire_barrier.srcQueueFamilyIndex = tq->family_index();
+      acquire_barrier.dstQueueFamilyIndex = cq->family_index();
+      acquire_barrier.buffer = *slot.buffer;
+      acquire_barrier.offset = 0;
+      acquire_barrier.size = VK_WHOLE_SIZE;
+      VkDependencyInfo acquire_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+      acquire_dependency_info.bufferMemoryBarrierCount = 1;
+      acquire_dependency_info.pBufferMemoryBarriers = &acquire_barrier;
+      vkCmdPipelineBarrier2(*cb, &acquire_dependency_info);
+
+      // chunk buffer[offset..] -> gaussian_splats[point_offset, point_offset + point_count) of each target
+      std::vector<std::shared_ptr<gpu::Object>> objects = {cb, tsem, csem, slot.buffer};
+      for (const auto& parse_chunk : parse_chunks) {
+        const auto& target = targets[parse_chunk.target];
+        const auto& output = outputs[parse_chunk.target];
+
+        ParsePushConstants parse_push_constants = {};
+        parse_push_constants.point_count = parse_chunk.point_count;
+        parse_push_constants.sh_degree = target.sh_degree;
+        parse_push_constants.point_offset = parse_chunk.point_offset;
+
+        cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *parse_pipeline_layout_,
+                             {{*slot.buffer, parse_chunk.offset, VK_WHOLE_SIZE},
+                              {*output.position, 0, VK_WHOLE_SIZE},
+                              {*output.cov3d, 0, VK_WHOLE_SIZE},
+                              {*output.opacity, 0, VK_WHOLE_SIZE},
+                              {*output.sh, 0, VK_WHOLE_SIZE}});
+        vkCmdPushConstants(*cb, *parse_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                           sizeof(parse_push_constants), &parse_push_constants);
+
+        vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *target.pipeline);
+        vkCmdDispatch(*cb, WorkgroupSize(parse_chunk.point_count, 256), 1, 1);
+
+        objects.insert(objects.end(), {target.pipeline, output.position, output.cov3d, output.sh, output.opacity});
+      }
+
+      // Visibility barrier
+      VkMemoryBarrier2 visibility_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+      visibility_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+      visibility_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+      visibility_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+      visibility_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+      VkDependencyInfo visibility_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+      visibility_dependency_info.memoryBarrierCount = 1;
+      visibility_dependency_info.pMemoryBarriers = &visibility_barrier;
+      vkCmdPipelineBarrier2(*cb, &visibility_dependency_info);
+
+      vkEndCommandBuffer(*cb);
+
+      // Submit
+      // T[k].xfer before C[k].parse
+      VkSemaphoreSubmitInfo wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      wait_semaphore_info.semaphore = *tsem;
+      wait_semaphore_info.value = tval + chunk + 1;
+      wait_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+      VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+      command_buffer_info.commandBuffer = *cb;
+
+      // C[k].parse
+      VkSemaphoreSubmitInfo signal_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      signal_semaphore_info.semaphore = *csem;
+      signal_semaphore_info.value = cval + chunk + 1;
+      signal_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+      VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+      submit.waitSemaphoreInfoCount = 1;
+      submit.pWaitSemaphoreInfos = &wait_semaphore_info;
+      submit.commandBufferInfoCount = 1;
+      submit.pCommandBufferInfos = &command_buffer_info;
+      submit.signalSemaphoreInfoCount = 1;
+      submit.pSignalSemaphoreInfos = &signal_semaphore_info;
+
+      // The fence of the last chunk of a target also covers its previous chunks on the compute queue.
+      vkQueueSubmit2(*cq, 1, &submit, *fence);
+      auto parse_task = task_monitor_->Add(fence, objects);
+      for (const auto& parse_chunk : parse_chunks) outputs[parse_chunk.target].task = parse_task;
+    }
+
+    if (task) {
+      for (const auto& parse_chunk : parse_chunks) task->AddProgress(parse_chunk.read_size, parse_chunk.point_count);
+    }
+  }
+
+  if (chunk < chunk_count) {
+    tsem->SetValue(tval + chunk);
+    csem->SetValue(cval + chunk);
+    throw std::runtime_error("Loading cancelled");
+  }
+
+  tsem->SetValue(tval + chunk_count);
+  csem->SetValue(cval + chunk_count);
+
+  std::vector<std::shared_ptr<GaussianSplats>> splats;
+  for (size_t i = 0; i < targets.size(); ++i) {
+    const auto& output = outputs[i];
+    splats.push_back(Track(std::make_shared<GaussianSplats>(targets[i].point_count, targets[i].sh_degree,
+                                                            output.position, output.cov3d, output.sh, output.opacity,
+                                                            output.task)));
+  }
+  return splats;
+}
+
+void Renderer::SaveSplats(std::shared_ptr<GaussianSplats> splats, const std::string& path) {
+  if (splats->quantized() || splats->interleaved() || splats->has_sh_codebook()) {
+    throw std::runtime_error("Only splats with the default layout can be saved: " + path);
+  }
+  splats->Wait();
+
+  auto sizes = SplatSectionSizes(splats->size(), splats->sh_degree());
+  std::array<uint64_t, kSplatFileSectionCount> offsets;
+  uint64_t file_size = SplatSectionOffsets(sizes, &offsets);
+
+  SplatFileHeader header = {};
+  std::memcpy(header.magic, kSplatFileMagic, sizeof(header.magic));
+  header.version = kSplatFileVersion;
+  header.point_count = splats->size();
+  header.sh_degree = splats->sh_degree();
+  header.section_count = kSplatFileSectionCount;
+  for (uint32_t i = 0; i < kSplatFileSectionCount; ++i) {
+    header.sections[i].offset = offsets[i];
+    header.sections[i].size = sizes[i];
+  }
+
+  // Read back into a host buffer with the file layout, then write it at once.
+  auto readback = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT, file_size, true);
+
+  std::shared_ptr<gpu::Task> task;
   {
-    auto cb = tq->AllocateCommandBuffer();
-    auto fence = device_->AllocateFence();
+    std::lock_guard<std::mutex> lock(*mutex_);
+    MakeResident(splats);
+    task = CopySplatSections(splats, readback, {offsets.begin(), offsets.end()}, true);
+  }
+  task->Wait();
 
-    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(*cb, &begin_info);
+  std::memcpy(readback->data(), &header, sizeof(header));
 
-    VkBufferCopy region = {0, 0, buffer_size};
-    vkCmdCopyBuffer(*cb, *ply_stage, *ply_buffer, 1, &region);
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Failed to open file for writing: " + path);
+  }
+  out.write(readback->data<char>(), file_size);
+  if (!out) {
+    throw std::runtime_error("Failed to write file: " + path);
+  }
+}
 
-    region = {0, 0, index_stage->size()};
-    vkCmdCopyBuffer(*cb, *index_stage, *index_buffer, 1, &region);
+std::shared_ptr<gpu::Task> Renderer::CopySplatSections(std::shared_ptr<GaussianSplats> splats,
+                                                       std::shared_ptr<gpu::Buffer> host,
+                                                       const std::vector<uint64_t>& offsets, bool download) {
+  auto buffers = splats->buffers();
+  const auto& sizes = splats->buffer_sizes();
 
-    // Release barrier
-    std::vector<VkBufferMemoryBarrier2> release_barriers(2);
-    release_barriers[0] = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
-    release_barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    release_barriers[0].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    release_barriers[0].srcQueueFamilyIndex = tq->family_index();
-    release_barriers[0].dstQueueFamilyIndex = cq->family_index();
-    release_barriers[0].buffer = *ply_buffer;
-    release_barriers[0].offset = 0;
-    release_barriers[0].size = VK_WHOLE_SIZE;
-    release_barriers[1] = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
-    release_barriers[1].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    release_barriers[1].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    release_barriers[1].srcQueueFamilyIndex = tq->family_index();
-    release_barriers[1].dstQueueFamilyIndex = gq->family_index();
-    release_barriers[1].buffer = *index_buffer;
-    release_barriers[1].offset = 0;
-    release_barriers[1].size = VK_WHOLE_SIZE;
-    VkDependencyInfo release_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    release_dependency_info.bufferMemoryBarrierCount = release_barriers.size();
-    release_dependency_info.pBufferMemoryBarriers = release_barriers.data();
-    vkCmdPipelineBarrier2(*cb, &release_dependency_info);
+  auto cq = device_->compute_queue();
+  auto cb = cq->AllocateCommandBuffer();
+  auto fence = device_->AllocateFence();
+
+  VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  vkBeginCommandBuffer(*cb, &begin_info);
+
+  VkMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &barrier;
+
+  // Copies are not waited on by the host, so order them after earlier writes of the splats or host, such as an upload
+  // from host still in flight or the download of an earlier eviction.
+  barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  barrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+  vkCmdPipelineBarrier2(*cb, &dependency_info);
+
+  if (download) {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      VkBufferCopy region = {0, offsets[i], sizes[i]};
+      vkCmdCopyBuffer(*cb, *buffers[i], *host, 1, &region);
+    }
+
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    vkCmdPipelineBarrier2(*cb, &dependency_info);
+  } else {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      VkBufferCopy region = {offsets[i], 0, sizes[i]};
+      vkCmdCopyBuffer(*cb, *host, *buffers[i], 1, &region);
+    }
+
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+    vkCmdPipelineBarrier2(*cb, &dependency_info);
+  }
+
+  vkEndCommandBuffer(*cb);
+
+  VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+  command_buffer_info.commandBuffer = *cb;
+
+  VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+  submit.commandBufferInfoCount = 1;
+  submit.pCommandBufferInfos = &command_buffer_info;
+  vkQueueSubmit2(*cq, 1, &submit, *fence);
+  std::vector<std::shared_ptr<gpu::Object>> objects = {cb, host};
+  objects.insert(objects.end(), buffers.begin(), buffers.end());
+  return task_monitor_->Add(fence, objects);
+}
+
+std::shared_ptr<GaussianSplats> Renderer::Track(std::shared_ptr<GaussianSplats> splats) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  for (const auto& buffer : splats->buffers()) buffer->set_tag(kMemoryTagSplats);
+  residency_manager_->Touch(splats);
+  EnforceBudget(0, splats.get());
+  return splats;
+}
+
+bool Renderer::MakeResident(std::shared_ptr<GaussianSplats> splats) {
+  residency_manager_->Touch(splats);
+  if (splats->resident()) return false;
+
+  EnforceBudget(splats->device_size(), splats.get());
+
+  std::vector<uint64_t> offsets;
+  PackedOffsets(splats->buffer_sizes(), &offsets);
+  auto host = splats->host();
+  std::vector<std::shared_ptr<gpu::Buffer>> buffers;
+  for (auto size : splats->buffer_sizes()) {
+    buffers.push_back(gpu::Buffer::Create(device_, kSplatBufferUsage, size));
+    buffers.back()->set_tag(kMemoryTagSplats);
+  }
+  splats->Restore(buffers);
+  // Ordered before the draw on the compute queue, no need to wait.
+  CopySplatSections(splats, host, offsets, false);
+  return true;
+}
+
+void Renderer::Evict(std::shared_ptr<GaussianSplats> splats) {
+  std::vector<uint64_t> offsets;
+  uint64_t size = PackedOffsets(splats->buffer_sizes(), &offsets);
+  auto host =
+      gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, size, true);
+  host->set_tag(kMemoryTagSplats);
+  // Not waited on. Loads and draws of splats are submitted to the compute queue before this copy, and an upload from
+  // host in MakeResident after it, so queue order and the barriers of CopySplatSections keep them apart.
+  CopySplatSections(splats, host, offsets, true);
+
+  // The task monitor keeps the device buffers alive until the copy and in-flight draws using them complete.
+  splats->Evict(host);
+  residency_manager_->AddEviction();
+}
+
+void Renderer::EnforceBudget(uint64_t required, const GaussianSplats* exclude) {
+  // Evicted buffers may be freed only after in-flight work, so they are counted as freed right away.
+  uint64_t freed = 0;
+  while (true) {
+    bool over_budget = false;
+    if (memory_budget_ > 0) {
+      over_budget = residency_manager_->resident_size() + required > memory_budget_;
+    } else {
+      VkDeviceSize usage = 0;
+      VkDeviceSize budget = 0;
+      device_->GetDeviceLocalBudget(&usage, &budget);
+      over_budget = usage - std::min(usage, freed) + required > budget;
+    }
+    if (!over_budget) break;
+
+    auto victim = residency_manager_->LeastRecentlyUsed(exclude);
+    if (victim == nullptr) break;
+    freed += victim->device_size();
+    Evict(victim);
+  }
+}
+
+void Renderer::SetMemoryBudget(uint64_t budget) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  memory_budget_ = budget;
+  EnforceBudget(0, nullptr);
+}
+
+ResidencyStats Renderer::GetResidencyStats() {
+  std::lock_guard<std::mutex> lock(*mutex_);
+  return residency_manager_->stats();
+}
+
+MemoryStats Renderer::GetMemoryStats() {
+  std::lock_guard<std::mutex> lock(*mutex_);
+
+  MemoryStats stats;
+  auto tagged = [this](uint32_t tag) {
+    return MemoryUsage{device_->tagged_memory(tag, false), device_->tagged_memory(tag, true)};
+  };
+  stats.splats = tagged(kMemoryTagSplats);
+  stats.sort_scratch = tagged(kMemoryTagSortScratch);
+  stats.sort_scratch_unaliased = scratch_pool_->UnaliasedSize();
+  stats.images = tagged(kMemoryTagImages);
+  stats.staging = tagged(kMemoryTagStaging);
+  stats.readback = tagged(kMemoryTagReadback);
+  stats.other = tagged(kMemoryTagOther);
+  task_monitor_->GetPendingMemory(&stats.pending_retire.device, &stats.pending_retire.host);
+  device_->GetAllocatedMemory(&stats.allocated.device, &stats.reserved.device, &stats.allocated.host,
+                              &stats.reserved.host);
+
+  for (const auto& splats : residency_manager_->splats()) {
+    SplatsMemory splats_memory;
+    splats_memory.point_count = splats->size();
+    splats_memory.sh_degree = splats->sh_degree();
+    splats_memory.resident = splats->resident();
+    splats_memory.size = splats->resident() ? splats->device_size() : splats->host()->size();
+    stats.splats_objects.push_back(splats_memory);
+  }
+  return stats;
+}
+
+std::string Renderer::GetMemoryStatsJson() {
+  auto stats = GetMemoryStats();
+
+  std::ostringstream out;
+  auto usage = [&out](const char* name, const MemoryUsage& usage) {
+    out << "\"" << name << "\": {\"device\": " << usage.device << ", \"host\": " << usage.host << "}, ";
+  };
+  out << "{";
+  usage("splats", stats.splats);
+  usage("sort_scratch", stats.sort_scratch);
+  out << "\"sort_scratch_unaliased\": " << stats.sort_scratch_unaliased << ", ";
+  usage("images", stats.images);
+  usage("staging", stats.staging);
+  usage("readback", stats.readback);
+  usage("other", stats.other);
+  usage("pending_retire", stats.pending_retire);
+  usage("allocated", stats.allocated);
+  usage("reserved", stats.reserved);
+  out << "\"splats_objects\": [";
+  for (size_t i = 0; i < stats.splats_objects.size(); ++i) {
+    const auto& splats = stats.splats_objects[i];
+    if (i > 0) out << ", ";
+    out << "{\"point_count\": " << splats.point_count << ", \"sh_degree\": " << splats.sh_degree
+        << ", \"resident\": " << (splats.resident ? "true" : "false") << ", \"size\": " << splats.size << "}";
+  }
+  out << "]}";
+  return out.str();
+}
+
+TimingStats Renderer::GetTimingStats() { return gpu_timer_->stats(); }
+
+std::shared_ptr<GaussianSplats> Renderer::LoadSplats(const std::string& path) {
+  MappedFile file(path);
+
+  SplatFileHeader header;
+  if (file.size() < sizeof(header)) {
+    throw std::runtime_error("Invalid splat file: " + path);
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, kSplatFileMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("Invalid splat file: " + path);
+  }
+  if (header.version != kSplatFileVersion) {
+    throw std::runtime_error("Unsupported splat file version " + std::to_string(header.version) + ": " + path);
+  }
+  if (header.section_count != kSplatFileSectionCount || header.sh_degree > 3 || header.point_count == 0 ||
+      header.point_count > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Invalid splat file: " + path);
+  }
+
+  uint32_t point_count = header.point_count;
+  uint32_t sh_degree = header.sh_degree;
+  auto sizes = SplatSectionSizes(point_count, sh_degree);
+  for (uint32_t i = 0; i < kSplatFileSectionCount; ++i) {
+    if (header.sections[i].size != sizes[i] || header.sections[i].offset > file.size() ||
+        header.sections[i].size > file.size() - header.sections[i].offset) {
+      throw std::runtime_error("Splat file is truncated or corrupt: " + path);
+    }
+  }
+
+  // allocate buffers
+  std::array<std::shared_ptr<gpu::Buffer>, kSplatFileSectionCount> buffers;
+  for (uint32_t i = 0; i < kSplatFileSectionCount; ++i) {
+    buffers[i] = gpu::Buffer::Create(device_, kSplatBufferUsage, sizes[i]);
+  }
+  auto position = buffers[kSplatFilePosition];
+  auto cov3d = buffers[kSplatFileCov3d];
+  auto sh = buffers[kSplatFileSh];
+  auto opacity = buffers[kSplatFileOpacity];
+
+  // Sections are copied from the mapping through the staging ring, packing consecutive sections into a
+  // staging buffer until it is full. No compute pass is needed, the file already has the GPU layout.
+  uint64_t total_size = 0;
+  for (auto size : sizes) total_size += size;
+  VkDeviceSize stage_size = std::min<uint64_t>(kStagingChunkSize, total_size);
+  uint32_t ring_size = std::min<uint64_t>(kStagingRingSize, (total_size + stage_size - 1) / stage_size);
+
+  struct StagingSlot {
+    std::shared_ptr<gpu::Buffer> stage;
+    std::shared_ptr<gpu::Task> task;
+  };
+  std::vector<StagingSlot> slots(ring_size);
+  for (auto& slot : slots) {
+    slot.stage = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, stage_size, true);
+    slot.stage->set_tag(kMemoryTagStaging);
+  }
+
+  auto sem = device_->AllocateSemaphore();
+  auto tq = device_->transfer_queue();
+  auto cq = device_->compute_queue();
+
+  std::shared_ptr<gpu::Task> task;
+
+  uint32_t stage_index = 0;
+  VkDeviceSize stage_offset = 0;
+  std::vector<std::pair<uint32_t, VkBufferCopy>> regions;  // (section, region)
+  for (uint32_t i = 0; i < kSplatFileSectionCount; ++i) {
+    for (VkDeviceSize offset = 0; offset < sizes[i];) {
+      auto& slot = slots[stage_index % ring_size];
+
+      // Wait until the previous copy from this staging buffer is done before overwriting it.
+      if (stage_offset == 0 && slot.task) {
+        slot.task->Wait();
+        slot.task = nullptr;
+      }
+
+      VkDeviceSize size = std::min(sizes[i] - offset, stage_size - stage_offset);
+      std::memcpy(slot.stage->data<char>() + stage_offset, file.data() + header.sections[i].offset + offset, size);
+      file.Release(header.sections[i].offset + offset, size);
+      regions.push_back({i, {stage_offset, offset, size}});
+      stage_offset += size;
+      offset += size;
+
+      bool last = i == kSplatFileSectionCount - 1 && offset == sizes[i];
+      if (stage_offset < stage_size && !last) continue;
+
+      // Transfer queue: stage to buffers
+      std::lock_guard<std::mutex> lock(*mutex_);
+      auto cb = tq->AllocateCommandBuffer();
+      auto fence = device_->AllocateFence();
+
+      VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+      begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+      vkBeginCommandBuffer(*cb, &begin_info);
 
-    vkEndCommandBuffer(*cb);
+      for (const auto& [section, region] : regions) {
+        vkCmdCopyBuffer(*cb, *slot.stage, *buffers[section], 1, &region);
+      }
 
-    VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
-    command_buffer_info.commandBuffer = *cb;
+      std::vector<VkSemaphoreSubmitInfo> signal_semaphore_infos;
+      if (last) {
+        // Release barrier, covering the copies of all previous submissions to the transfer queue.
+        std::vector<VkBufferMemoryBarrier2> release_barriers(kSplatFileSectionCount);
+        for (size_t j = 0; j < release_barriers.size(); ++j) {
+          release_barriers[j] = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
+          release_barriers[j].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+          release_barriers[j].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+          release_barriers[j].srcQueueFamilyIndex = tq->family_index();
+          release_barriers[j].dstQueueFamilyIndex = cq->family_index();
+          release_barriers[j].buffer = *buffers[j];
+          release_barriers[j].offset = 0;
+          release_barriers[j].size = VK_WHOLE_SIZE;
+        }
+        VkDependencyInfo release_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+        release_dependency_info.bufferMemoryBarrierCount = release_barriers.size();
+        release_dependency_info.pBufferMemoryBarriers = release_barriers.data();
+        vkCmdPipelineBarrier2(*cb, &release_dependency_info);
+
+        auto& signal_semaphore_info = signal_semaphore_infos.emplace_back();
+        signal_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+        signal_semaphore_info.semaphore = *sem;
+        signal_semaphore_info.value = sem->value() + 1;
+        signal_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+      }
 
-    VkSemaphoreSubmitInfo signal_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
-    signal_semaphore_info.semaphore = *sem;
-    signal_semaphore_info.value = sem->value() + 1;
-    signal_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+      vkEndCommandBuffer(*cb);
 
-    VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
-    submit.commandBufferInfoCount = 1;
-    submit.pCommandBufferInfos = &command_buffer_info;
-    submit.signalSemaphoreInfoCount = 1;
-    submit.pSignalSemaphoreInfos = &signal_semaphore_info;
+      VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+      command_buffer_info.commandBuffer = *cb;
 
-    vkQueueSubmit2(*tq, 1, &submit, *fence);
-    task_monitor_->Add(fence, {cb, sem, ply_stage, ply_buffer, index_stage, index_buffer});
+      VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+      submit.commandBufferInfoCount = 1;
+      submit.pCommandBufferInfos = &command_buffer_info;
+      submit.signalSemaphoreInfoCount = signal_semaphore_infos.size();
+      submit.pSignalSemaphoreInfos = signal_semaphore_infos.data();
+
+      vkQueueSubmit2(*tq, 1, &submit, *fence);
+      slot.task = task_monitor_->Add(fence, {cb, sem, slot.stage, position, cov3d, sh, opacity});
+
+      regions.clear();
+      stage_offset = 0;
+      stage_index++;
+    }
   }
 
-  // Compute queue: parse ply
+  // Compute queue: acquire splat buffers
   {
+    std::lock_guard<std::mutex> lock(*mutex_);
     auto cb = cq->AllocateCommandBuffer();
     auto fence = device_->AllocateFence();
 
@@ -655,47 +1834,28 @@ std::shared_ptr<GaussianSplats> Renderer::LoadFromPly(const std::string& path, i
     begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(*cb, &begin_info);
 
-    // Acquire barrier
-    VkBufferMemoryBarrier2 acquire_barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
-    acquire_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    acquire_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
-    acquire_barrier.srcQueueFamilyIndex = tq->family_index();
-    acquire_barrier.dstQueueFamilyIndex = cq->family_index();
-    acquire_barrier.buffer = *ply_buffer;
-    acquire_barrier.offset = 0;
-    acquire_barrier.size = VK_WHOLE_SIZE;
+    std::vector<VkBufferMemoryBarrier2> acquire_barriers(kSplatFileSectionCount);
+    for (size_t i = 0; i < acquire_barriers.size(); ++i) {
+      acquire_barriers[i] = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
+      acquire_barriers[i].dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+      acquire_barriers[i].dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+      acquire_barriers[i].srcQueueFamilyIndex = tq->family_index();
+      acquire_barriers[i].dstQueueFamilyIndex = cq->family_index();
+      acquire_barriers[i].buffer = *buffers[i];
+      acquire_barriers[i].offset = 0;
+      acquire_barriers[i].size = VK_WHOLE_SIZE;
+    }
     VkDependencyInfo acquire_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    acquire_dependency_info.bufferMemoryBarrierCount = 1;
-    acquire_dependency_info.pBufferMemoryBarriers = &acquire_barrier;
+    acquire_dependency_info.bufferMemoryBarrierCount = acquire_barriers.size();
+    acquire_dependency_info.pBufferMemoryBarriers = acquire_barriers.data();
     vkCmdPipelineBarrier2(*cb, &acquire_dependency_info);
 
-    // ply_buffer -> gaussian_splats
-    cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *parse_pipeline_layout_,
-                         {*ply_buffer, *position, *cov3d, *opacity, *sh});
-    vkCmdPushConstants(*cb, *parse_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(parse_ply_push_constants),
-                       &parse_ply_push_constants);
-
-    vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *parse_ply_pipeline_);
-    vkCmdDispatch(*cb, WorkgroupSize(point_count, 256), 1, 1);
-
-    // Visibility barrier
-    VkMemoryBarrier2 visibility_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
-    visibility_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    visibility_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
-    visibility_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    visibility_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
-    VkDependencyInfo visibility_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    visibility_dependency_info.memoryBarrierCount = 1;
-    visibility_dependency_info.pMemoryBarriers = &visibility_barrier;
-    vkCmdPipelineBarrier2(*cb, &visibility_dependency_info);
-
     vkEndCommandBuffer(*cb);
 
-    // Submit
     VkSemaphoreSubmitInfo wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
     wait_semaphore_info.semaphore = *sem;
     wait_semaphore_info.value = sem->value() + 1;
-    wait_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    wait_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
 
     VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
     command_buffer_info.commandBuffer = *cb;
@@ -705,83 +1865,544 @@ std::shared_ptr<GaussianSplats> Renderer::LoadFromPly(const std::string& path, i
     submit.pWaitSemaphoreInfos = &wait_semaphore_info;
     submit.commandBufferInfoCount = 1;
     submit.pCommandBufferInfos = &command_buffer_info;
-
     vkQueueSubmit2(*cq, 1, &submit, *fence);
-    task = task_monitor_->Add(fence, {cb, sem, parse_ply_pipeline_, ply_buffer, position, cov3d, sh, opacity});
+    task = task_monitor_->Add(fence, {cb, sem, position, cov3d, sh, opacity});
+  }
+
+  sem->Increment();
+
+  return Track(std::make_shared<GaussianSplats>(point_count, sh_degree, position, cov3d, sh, opacity, task));
+}
+
+std::shared_ptr<GaussianSplats> Renderer::Quantize(std::shared_ptr<GaussianSplats> splats) {
+  if (splats->quantized()) return splats;
+  if (splats->interleaved()) {
+    throw std::runtime_error("Interleaved splats cannot be quantized");
   }
+  splats->Wait();
 
-  // Graphics queue: acquire index buffer
+  uint32_t point_count = splats->size();
+  uint32_t chunk_count = WorkgroupSize(point_count, kQuantizeChunkSize);
+  // f16 positions are padded to a word.
+  auto position = gpu::Buffer::Create(device_, kSplatBufferUsage, (point_count * 3 * sizeof(uint16_t) + 3) / 4 * 4);
+  auto cov3d = gpu::Buffer::Create(device_, kSplatBufferUsage, point_count * 6 * sizeof(uint16_t));
+  auto opacity = gpu::Buffer::Create(device_, kSplatBufferUsage, (point_count + 3) / 4 * sizeof(uint32_t));
+  auto chunk = gpu::Buffer::Create(device_, kSplatBufferUsage, chunk_count * 4 * sizeof(float));
+
+  std::shared_ptr<gpu::Buffer> sh;
+  std::shared_ptr<gpu::Task> task;
   {
-    auto cb = gq->AllocateCommandBuffer();
+    std::lock_guard<std::mutex> lock(*mutex_);
+    MakeResident(splats);
+    auto src_position = splats->position();
+    auto src_cov3d = splats->cov3d();
+    auto src_sh = splats->sh();
+    auto src_opacity = splats->opacity();
+    sh = gpu::Buffer::Create(device_, kSplatBufferUsage, src_sh->size());
+
+    auto cq = device_->compute_queue();
+    auto cb = cq->AllocateCommandBuffer();
     auto fence = device_->AllocateFence();
 
     VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
     begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(*cb, &begin_info);
 
-    // Acquire barrier
-    VkBufferMemoryBarrier2 acquire_barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
-    acquire_barrier.dstStageMask = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
-    acquire_barrier.dstAccessMask = VK_ACCESS_2_INDEX_READ_BIT;
-    acquire_barrier.srcQueueFamilyIndex = tq->family_index();
-    acquire_barrier.dstQueueFamilyIndex = gq->family_index();
-    acquire_barrier.buffer = *index_buffer;
-    acquire_barrier.offset = 0;
-    acquire_barrier.size = VK_WHOLE_SIZE;
-    VkDependencyInfo acquire_dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    acquire_dependency_info.bufferMemoryBarrierCount = 1;
-    acquire_dependency_info.pBufferMemoryBarriers = &acquire_barrier;
-    vkCmdPipelineBarrier2(*cb, &acquire_dependency_info);
+    // SH coefficients are copied as they are, so the quantized splats own all of their buffers.
+    VkBufferCopy region = {0, 0, src_sh->size()};
+    vkCmdCopyBuffer(*cb, *src_sh, *sh, 1, &region);
 
-    vkEndCommandBuffer(*cb);
+    ParsePushConstants push_constants = {};
+    push_constants.point_count = point_count;
+    cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *parse_pipeline_layout_,
+                         {*src_position, *src_cov3d, *src_opacity, *position, *cov3d, *opacity, *chunk});
+    vkCmdPushConstants(*cb, *parse_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants),
+                       &push_constants);
+    vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *quantize_pipeline_);
+    vkCmdDispatch(*cb, chunk_count, 1, 1);
+
+    VkMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT;
+    VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+    dependency_info.memoryBarrierCount = 1;
+    dependency_info.pMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(*cb, &dependency_info);
 
-    // Submit
-    VkSemaphoreSubmitInfo wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
-    wait_semaphore_info.semaphore = *sem;
-    wait_semaphore_info.value = sem->value() + 1;
-    wait_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    vkEndCommandBuffer(*cb);
 
     VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
     command_buffer_info.commandBuffer = *cb;
 
     VkSubmitInfo2 submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
-    submit.waitSemaphoreInfoCount = 1;
-    submit.pWaitSemaphoreInfos = &wait_semaphore_info;
     submit.commandBufferInfoCount = 1;
     submit.pCommandBufferInfos = &command_buffer_info;
+    vkQueueSubmit2(*cq, 1, &submit, *fence);
+    task = task_monitor_->Add(
+        fence, {cb, src_position, src_cov3d, src_sh, src_opacity, position, cov3d, sh, opacity, chunk});
+  }
+
+  return Track(std::make_shared<GaussianSplats>(point_count, splats->sh_degree(), position, cov3d, sh, opacity, task,
+                                                chunk));
+}
 
-    vkQueueSubmit2(*gq, 1, &submit, *fence);
-    task_monitor_->Add(fence, {cb, sem, index_buffer});
+std::shared_ptr<GaussianSplats> Renderer::Interleave(std::shared_ptr<GaussianSplats> splats) {
+  if (splats->interleaved()) return splats;
+  if (splats->quantized()) {
+    throw std::runtime_error("Quantized splats cannot be interleaved");
+  }
+  splats->Wait();
+
+  uint32_t point_count = splats->size();
+  auto position = gpu::Buffer::Create(device_, kSplatBufferUsage, point_count * 4 * sizeof(float));
+  auto cov3d =
+      gpu::Buffer::Create(device_, kSplatBufferUsage, (point_count + (point_count + 1) / 2) * 4 * sizeof(float));
+
+  std::shared_ptr<gpu::Buffer> sh;
+  std::shared_ptr<gpu::Buffer> sh_codebook;
+  std::shared_ptr<gpu::Task> task;
+  {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    MakeResident(splats);
+    auto src_position = splats->position();
+    auto src_cov3d = splats->cov3d();
+    auto src_sh = splats->sh();
+    auto src_opacity = splats->opacity();
+    auto src_sh_codebook = splats->sh_codebook();
+
+    // SH buffers are copied as they are, so the interleaved splats own all of their buffers.
+    sh = gpu::Buffer::Create(device_, kSplatBufferUsage, src_sh->size());
+    std::vector<std::shared_ptr<gpu::Object>> objects = {src_position, src_cov3d, src_sh, src_opacity, position, cov3d,
+                                                         sh};
+    if (src_sh_codebook) {
+      sh_codebook = gpu::Buffer::Create(device_, kSplatBufferUsage, src_sh_codebook->size());
+      objects.push_back(src_sh_codebook);
+      objects.push_back(sh_codebook);
+    }
+
+    ParsePushConstants push_constants = {};
+    push_constants.point_count = point_count;
+    task = SubmitCompute(
+        *device_, *task_monitor_,
+        [&](VkCommandBuffer cb) {
+          VkBufferCopy region = {0, 0, src_sh->size()};
+          vkCmdCopyBuffer(cb, *src_sh, *sh, 1, &region);
+          if (src_sh_codebook) {
+            region = {0, 0, src_sh_codebook->size()};
+            vkCmdCopyBuffer(cb, *src_sh_codebook, *sh_codebook, 1, &region);
+          }
+
+          cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *parse_pipeline_layout_,
+                               {*src_position, *src_cov3d, *src_opacity, *position, *cov3d});
+          vkCmdPushConstants(cb, *parse_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants),
+                             &push_constants);
+          vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *interleave_pipeline_);
+          vkCmdDispatch(cb, WorkgroupSize(point_count, 256), 1, 1);
+        },
+        objects);
   }
-  sem->Increment();
 
-  return std::make_shared<GaussianSplats>(point_count, sh_degree, position, cov3d, sh, opacity, index_buffer, task);
+  return Track(std::make_shared<GaussianSplats>(point_count, splats->sh_degree(), position, cov3d, sh, nullptr, task,
+                                                nullptr, sh_codebook));
 }
 
-std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> splats, const DrawOptions& draw_options,
-                                              uint8_t* dst) {
-  std::shared_ptr<RenderedImage> rendered_image;
+std::shared_ptr<GaussianSplats> Renderer::Reorder(std::shared_ptr<GaussianSplats> splats) {
+  if (splats->quantized() || splats->interleaved() || splats->has_sh_codebook()) {
+    throw std::runtime_error("Only splats in the default layout can be reordered");
+  }
+  splats->Wait();
+
+  uint32_t point_count = splats->size();
+  uint32_t sh_degree = splats->sh_degree();
+  auto key = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * sizeof(uint32_t));
+  auto index = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, point_count * sizeof(uint32_t));
+  auto bounds = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                    6 * sizeof(uint32_t));
+  auto storage_requirements = sorter_->GetStorageRequirements(point_count);
+  auto sort_storage = gpu::Buffer::Create(device_, storage_requirements.usage, storage_requirements.size);
+
+  std::shared_ptr<gpu::Buffer> position;
+  std::shared_ptr<gpu::Buffer> cov3d;
+  std::shared_ptr<gpu::Buffer> sh;
+  std::shared_ptr<gpu::Buffer> opacity;
+  std::shared_ptr<gpu::Task> task;
+  {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    MakeResident(splats);
+    auto src_position = splats->position();
+    auto src_cov3d = splats->cov3d();
+    auto src_sh = splats->sh();
+    auto src_opacity = splats->opacity();
+    position = gpu::Buffer::Create(device_, kSplatBufferUsage, src_position->size());
+    cov3d = gpu::Buffer::Create(device_, kSplatBufferUsage, src_cov3d->size());
+    sh = gpu::Buffer::Create(device_, kSplatBufferUsage, src_sh->size());
+    opacity = gpu::Buffer::Create(device_, kSplatBufferUsage, src_opacity->size());
+
+    ParsePushConstants parse_push_constants = {};
+    parse_push_constants.point_count = point_count;
+    ComputePushConstants compute_push_constants = {};
+    compute_push_constants.point_count = point_count;
+    compute_push_constants.sh_degree_data = sh_degree;
+    task = SubmitCompute(
+        *device_, *task_monitor_,
+        [&](VkCommandBuffer cb) {
+          // Bounds are min xyz and max xyz as order-preserving bits, starting from the empty range.
+          vkCmdFillBuffer(cb, *bounds, 0, 3 * sizeof(uint32_t), -1);
+          vkCmdFillBuffer(cb, *bounds, 3 * sizeof(uint32_t), 3 * sizeof(uint32_t), 0);
+          ComputeBarrier(cb);
+
+          cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *parse_pipeline_layout_,
+                               {*src_position, *bounds, *key, *index});
+          vkCmdPushConstants(cb, *parse_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                             sizeof(parse_push_constants), &parse_push_constants);
+          vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *morton_bounds_pipeline_);
+          vkCmdDispatch(cb, WorkgroupSize(point_count, 256), 1, 1);
+          ComputeBarrier(cb);
+
+          vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *morton_pipeline_);
+          vkCmdDispatch(cb, WorkgroupSize(point_count, 256), 1, 1);
+          ComputeBarrier(cb);
+
+          sorter_->SortKeyValue(cb, point_count, *key, *index, *sort_storage);
+          ComputeBarrier(cb);
+
+          cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
+                               {*index, *src_position, *src_cov3d, *src_opacity, *src_sh, *position, *cov3d, *opacity,
+                                *sh});
+          vkCmdPushConstants(cb, *compute_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                             sizeof(compute_push_constants), &compute_push_constants);
+          vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *reorder_pipeline_);
+          vkCmdDispatch(cb, WorkgroupSize(point_count, 256), 1, 1);
+        },
+        {src_position, src_cov3d, src_sh, src_opacity, position, cov3d, sh, opacity, key, index, bounds,
+         sort_storage});
+  }
 
-  uint32_t width = draw_options.width;
-  uint32_t height = draw_options.height;
+  return Track(std::make_shared<GaussianSplats>(point_count, sh_degree, position, cov3d, sh, opacity, task));
+}
 
-  auto cq = device_->compute_queue();
-  auto gq = device_->graphics_queue();
-  auto tq = device_->transfer_queue();
+std::shared_ptr<GaussianSplats> Renderer::CompressSh(std::shared_ptr<GaussianSplats> splats, uint32_t codebook_size) {
+  if (splats->has_sh_codebook() || splats->sh_degree() == 0) return splats;
+  if (codebook_size == 0 || codebook_size > 65536) {
+    throw std::runtime_error("SH codebook size must be in [1, 65536], got " + std::to_string(codebook_size));
+  }
+  splats->Wait();
+
+  uint32_t point_count = splats->size();
+  uint32_t sh_degree = splats->sh_degree();
+  uint32_t packed_size = kShPackedSizes[sh_degree];
+  uint32_t dim = packed_size * 4;
+  uint64_t code_size = dim * sizeof(uint16_t);
+  codebook_size = std::min(codebook_size, point_count);
+  uint32_t sample_count =
+      std::min<uint64_t>(point_count, static_cast<uint64_t>(codebook_size) * kShCodebookSamplesPerCode);
+
+  // k-means is trained on evenly spaced samples. Samples are assigned to codewords on the GPU and codewords are
+  // updated on the CPU, through host-visible buffers.
+  constexpr VkBufferUsageFlags usage =
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  auto samples = gpu::Buffer::Create(device_, usage, sample_count * code_size, true);
+  auto assignments = gpu::Buffer::Create(device_, usage, sample_count * 2 * sizeof(uint32_t), true);
+  auto codebook = gpu::Buffer::Create(device_, usage, codebook_size * code_size, true);
+
+  std::shared_ptr<gpu::Task> task;
+  {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    MakeResident(splats);
+    auto sh = splats->sh();
+    std::vector<VkBufferCopy> regions(sample_count);
+    for (uint32_t i = 0; i < sample_count; ++i) {
+      regions[i] = {static_cast<uint64_t>(i) * point_count / sample_count * code_size, i * code_size, code_size};
+    }
+    task = SubmitCompute(
+        *device_, *task_monitor_,
+        [&](VkCommandBuffer cb) { vkCmdCopyBuffer(cb, *sh, *samples, regions.size(), regions.data()); },
+        {sh, samples});
+  }
+  task->Wait();
+
+  const auto* sample_data = samples->data<uint16_t>();
+  auto* code_data = codebook->data<uint16_t>();
+  for (uint32_t k = 0; k < codebook_size; ++k) {
+    std::memcpy(code_data + k * dim, sample_data + static_cast<uint64_t>(k) * sample_count / codebook_size * dim,
+                code_size);
+    ZeroShDc(code_data + k * dim, packed_size);
+  }
+
+  ShCodebookPushConstants push_constants = {};
+  push_constants.sh_degree = sh_degree;
+  push_constants.codebook_size = codebook_size;
+  auto assign = [&](VkCommandBuffer cb, VkBuffer sh, VkBuffer codebook, VkBuffer output, uint32_t count) {
+    push_constants.point_count = count;
+    cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *parse_pipeline_layout_, {sh, codebook, output});
+    vkCmdPushConstants(cb, *parse_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants),
+                       &push_constants);
+    vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *sh_codebook_pipeline_);
+    vkCmdDispatch(cb, WorkgroupSize(count, 256), 1, 1);
+  };
+
+  for (uint32_t iteration = 0; iteration < kShCodebookIterations; ++iteration) {
+    {
+      std::lock_guard<std::mutex> lock(*mutex_);
+      task = SubmitCompute(
+          *device_, *task_monitor_,
+          [&](VkCommandBuffer cb) { assign(cb, *samples, *codebook, *assignments, sample_count); },
+          {samples, codebook, assignments});
+    }
+    task->Wait();
+    UpdateShCodebook(sample_data, assignments->data<uint32_t>(), sample_count, packed_size, codebook_size,
+                     code_data);
+  }
+
+  // Other buffers are copied as they are, so the new splats own all of their buffers.
+  std::vector<std::shared_ptr<gpu::Buffer>> buffers;
+  auto sh_codebook = gpu::Buffer::Create(device_, kSplatBufferUsage, codebook->size());
+  {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    MakeResident(splats);
+    auto src = splats->buffers();
+    for (size_t i = 0; i < src.size(); ++i) {
+      uint64_t size = i == kSplatFileSh ? point_count * 2 * sizeof(uint32_t) : src[i]->size();
+      buffers.push_back(gpu::Buffer::Create(device_, kSplatBufferUsage, size));
+    }
+
+    std::vector<std::shared_ptr<gpu::Object>> objects = {codebook, sh_codebook};
+    objects.insert(objects.end(), src.begin(), src.end());
+    objects.insert(objects.end(), buffers.begin(), buffers.end());
+    task = SubmitCompute(
+        *device_, *task_monitor_,
+        [&](VkCommandBuffer cb) {
+          for (size_t i = 0; i < buffers.size(); ++i) {
+            if (i == kSplatFileSh) continue;
+            VkBufferCopy region = {0, 0, src[i]->size()};
+            vkCmdCopyBuffer(cb, *src[i], *buffers[i], 1, &region);
+          }
+          VkBufferCopy region = {0, 0, codebook->size()};
+          vkCmdCopyBuffer(cb, *codebook, *sh_codebook, 1, &region);
+          assign(cb, *src[kSplatFileSh], *codebook, *buffers[kSplatFileSh], point_count);
+        },
+        objects);
+  }
 
+  // Remaining buffers in the order of GaussianSplats::buffers().
+  size_t i = kSplatFileOpacity;
+  auto opacity = splats->interleaved() ? nullptr : buffers[i++];
+  auto chunk = splats->quantized() ? buffers[i++] : nullptr;
+  return Track(std::make_shared<GaussianSplats>(point_count, sh_degree, buffers[kSplatFilePosition],
+                                                buffers[kSplatFileCov3d], buffers[kSplatFileSh], opacity, task, chunk,
+                                                sh_codebook));
+}
+
+void Renderer::RecordProjection(gpu::Command& cb, std::shared_ptr<GaussianSplats> splats,
+                                const DrawOptions* draw_options, uint32_t view_count,
+                                const ComputeStorage& compute_storage, gpu::QueryPool* rank_queries) {
   auto N = splats->size();
+  // Views are sorted together, instances of all views in (view_count * N) scratch.
+  uint32_t instance_count = view_count * N;
   auto position = splats->position();
   auto cov3d = splats->cov3d();
   auto sh = splats->sh();
-  auto opacity = splats->opacity();
-  auto index_buffer = splats->index_buffer();
+  // Opacity is in position for interleaved splats, binding it again where the pipelines do not read it.
+  auto opacity = splats->interleaved() ? position : splats->opacity();
+  auto chunk = splats->chunk();
+  auto sh_codebook = splats->sh_codebook();
+
+  // Pipelines decoding the storage of splats.
+  auto rank_pipeline = rank_pipeline_;
+  auto projection_pipeline = sh_codebook ? projection_sh_codebook_pipeline_ : projection_pipeline_;
+  if (splats->quantized()) {
+    rank_pipeline = rank_quantized_pipeline_;
+    projection_pipeline = sh_codebook ? projection_quantized_sh_codebook_pipeline_ : projection_quantized_pipeline_;
+  } else if (splats->interleaved()) {
+    rank_pipeline = rank_interleaved_pipeline_;
+    projection_pipeline =
+        sh_codebook ? projection_interleaved_sh_codebook_pipeline_ : projection_interleaved_pipeline_;
+  }
 
   ComputePushConstants compute_push_constants;
   compute_push_constants.model = glm::mat4(1.f);
   compute_push_constants.point_count = N;
-  compute_push_constants.eps2d = draw_options.eps2d;
+  compute_push_constants.eps2d = draw_options[0].eps2d;
   compute_push_constants.sh_degree_data = splats->sh_degree();
-  compute_push_constants.sh_degree_draw = draw_options.sh_degree == -1 ? splats->sh_degree() : draw_options.sh_degree;
+  compute_push_constants.sh_degree_draw =
+      draw_options[0].sh_degree == -1 ? splats->sh_degree() : draw_options[0].sh_degree;
+  compute_push_constants.view_count = view_count;
+  compute_push_constants.sorted_order = draw_options[0].sorted_projection ? 1u : 0u;
+
+  std::vector<Camera> camera_data(view_count);
+  for (uint32_t i = 0; i < view_count; ++i) {
+    camera_data[i].projection = draw_options[i].projection;
+    camera_data[i].view = draw_options[i].view;
+    camera_data[i].camera_position = glm::inverse(draw_options[i].view)[3];
+    camera_data[i].screen_size = glm::uvec2(draw_options[i].width, draw_options[i].height);
+  }
+
+  auto visible_point_count = compute_storage.visible_point_count();
+  auto key = compute_storage.key();
+  auto index = compute_storage.index();
+  auto sort_storage = compute_storage.sort_storage();
+  auto inverse_index = compute_storage.inverse_index();
+  auto camera = compute_storage.camera();
+  auto draw_indirect = compute_storage.draw_indirect();
+  auto dispatch_indirect = compute_storage.dispatch_indirect();
+  auto instances = compute_storage.instances();
+  auto camera_stage = upload_ring_->buffer();
+  auto camera_upload = upload_ring_->Allocate(view_count * sizeof(Camera));
+  std::memcpy(camera_upload.data, camera_data.data(), view_count * sizeof(Camera));
+
+  VkBufferCopy region = {camera_upload.offset, 0, view_count * sizeof(Camera)};
+  vkCmdCopyBuffer(cb, *camera_stage, *camera, 1, &region);
+  // Total and per-view counts.
+  vkCmdFillBuffer(cb, *visible_point_count, 0, VK_WHOLE_SIZE, 0);
+
+  VkMemoryBarrier2 memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  memory_barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+  VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &memory_barrier;
+  vkCmdPipelineBarrier2(cb, &dependency_info);
+
+  // Rank
+  cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
+                       {
+                           *camera,
+                           *position,
+                           *visible_point_count,
+                           *key,
+                           *index,
+                       });
+  if (chunk) cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_, {*chunk}, 9);
+  vkCmdPushConstants(cb, *compute_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(compute_push_constants),
+                     &compute_push_constants);
+  vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *rank_pipeline);
+  if (rank_queries) vkCmdWriteTimestamp2(cb, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, *rank_queries, 0);
+  vkCmdDispatch(cb, WorkgroupSize(N, 256), view_count, 1);
+  if (rank_queries) vkCmdWriteTimestamp2(cb, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, *rank_queries, 1);
+
+  // Sort
+  memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  memory_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+  memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT;
+  dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &memory_barrier;
+  vkCmdPipelineBarrier2(cb, &dependency_info);
+
+  // Dispatch size of passes over visible instances, read after the sort.
+  cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
+                       {
+                           *visible_point_count,
+                           *dispatch_indirect,
+                       });
+  vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *dispatch_indirect_pipeline_);
+  vkCmdDispatch(cb, 1, 1, 1);
+
+  sorter_->SortKeyValueIndirect(cb, instance_count, *visible_point_count, *key, *index, *sort_storage);
+
+  // Inverse index, aliasing key, and later instances, aliasing sort storage, are written after the sort.
+  memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  memory_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+                                VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT |
+                                 VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &memory_barrier;
+  vkCmdPipelineBarrier2(cb, &dependency_info);
+
+  // Projection in sorted order reads sorted index directly, one thread per visible instance. Otherwise one thread per
+  // point reads its sorted position from the inverse index.
+  auto instance_map = index;
+  if (!draw_options[0].sorted_projection) {
+    RecordInverseIndex(cb, instance_count, compute_storage);
+    instance_map = inverse_index;
+  }
+
+  // Projection
+  cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
+                       {
+                           *camera,
+                           *position,
+                           *cov3d,
+                           *opacity,
+                           *sh,
+                           *visible_point_count,
+                           *instance_map,
+                           *draw_indirect,
+                           *instances,
+                       });
+  if (chunk) cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_, {*chunk}, 9);
+  if (sh_codebook) {
+    cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_, {*sh_codebook}, 10);
+  }
+  vkCmdPushConstants(cb, *compute_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(compute_push_constants),
+                     &compute_push_constants);
+  vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *projection_pipeline);
+  if (draw_options[0].sorted_projection) {
+    vkCmdDispatchIndirect(cb, *dispatch_indirect, 0);
+  } else {
+    vkCmdDispatch(cb, WorkgroupSize(N, 256), view_count, 1);
+  }
+}
+
+void Renderer::RecordInverseIndex(gpu::Command& cb, uint32_t instance_count, const ComputeStorage& compute_storage) {
+  auto visible_point_count = compute_storage.visible_point_count();
+  auto index = compute_storage.index();
+  auto inverse_index = compute_storage.inverse_index();
+  auto dispatch_indirect = compute_storage.dispatch_indirect();
+
+  vkCmdFillBuffer(cb, *inverse_index, 0, instance_count * sizeof(uint32_t), -1);
+
+  VkMemoryBarrier2 memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  memory_barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+  VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &memory_barrier;
+  vkCmdPipelineBarrier2(cb, &dependency_info);
+
+  cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
+                       {
+                           *visible_point_count,
+                           *index,
+                           *inverse_index,
+                       });
+  vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_COMPUTE, *inverse_index_pipeline_);
+  vkCmdDispatchIndirect(cb, *dispatch_indirect, 0);
+
+  memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  memory_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+  memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+  dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.memoryBarrierCount = 1;
+  dependency_info.pMemoryBarriers = &memory_barrier;
+  vkCmdPipelineBarrier2(cb, &dependency_info);
+}
+
+void Renderer::RecordSplats(gpu::Command& cb, const DrawOptions& draw_options,
+                            const GraphicsStorage& graphics_storage, const ComputeStorage& compute_storage,
+                            uint32_t view) {
+  uint32_t width = draw_options.width;
+  uint32_t height = draw_options.height;
+  auto image = graphics_storage.image();
+  auto depth_image = graphics_storage.depth_image();
+  auto draw_indirect = compute_storage.draw_indirect();
+  auto instances = compute_storage.instances();
+  // Instances of the view are a range of the sorted instances, given by its draw command.
+  VkDeviceSize draw_indirect_offset = view * sizeof(VkDrawIndirectCommand);
 
   GraphicsPushConstants graphics_push_constants;
   graphics_push_constants.background = glm::vec4(draw_options.background, 1.f);
@@ -791,25 +2412,143 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
   graphics_push_constants.camera_near = draw_options.camera_near;
   graphics_push_constants.camera_far = draw_options.camera_far;
 
-  Camera camera_data;
-  camera_data.projection = draw_options.projection;
-  camera_data.view = draw_options.view;
-  camera_data.camera_position = glm::inverse(draw_options.view)[3];
-  camera_data.screen_size = glm::uvec2(width, height);
+  // Layout transition to color attachment
+  VkImageMemoryBarrier2 image_memory_barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+  image_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+  image_memory_barrier.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+  image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+  image_memory_barrier.image = *image;
+  image_memory_barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+  // Layout transition for depth attachment
+  VkImageMemoryBarrier2 depth_memory_barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+  depth_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+  depth_memory_barrier.dstAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+  depth_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  depth_memory_barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+  depth_memory_barrier.image = *depth_image;
+  depth_memory_barrier.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
+
+  std::array<VkImageMemoryBarrier2, 2> image_barriers = {image_memory_barrier, depth_memory_barrier};
+  VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency_info.imageMemoryBarrierCount = image_barriers.size();
+  dependency_info.pImageMemoryBarriers = image_barriers.data();
+  vkCmdPipelineBarrier2(cb, &dependency_info);
+
+  // Rendering
+  VkRenderingAttachmentInfo color_attachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO};
+  color_attachment.imageView = image->image_view();
+  color_attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+  color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+  color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+  color_attachment.clearValue.color = {0.f, 0.f, 0.f, 0.f};
+
+  VkRenderingAttachmentInfo depth_attachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO};
+  depth_attachment.imageView = depth_image->image_view();
+  depth_attachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+  depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+  depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+  depth_attachment.clearValue.depthStencil.depth = 1.0f;
+
+  VkRenderingInfo rendering_info = {VK_STRUCTURE_TYPE_RENDERING_INFO};
+  rendering_info.renderArea.offset = {0, 0};
+  rendering_info.renderArea.extent = {width, height};
+  rendering_info.layerCount = 1;
+  rendering_info.colorAttachmentCount = 1;
+  rendering_info.pColorAttachments = &color_attachment;
+  rendering_info.pDepthAttachment = &depth_attachment;
+
+  // If auto-range is enabled, first render with depth writing to populate depth buffer
+  if (draw_options.depth_auto_range && draw_options.depth_z_min_out && draw_options.depth_z_max_out) {
+    vkCmdBeginRendering(cb, &rendering_info);
+
+    vkCmdPushConstants(cb, *graphics_pipeline_layout_, VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+                       sizeof(graphics_push_constants), &graphics_push_constants);
+
+    // Use depth-write pipeline to populate depth buffer
+    vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *splat_pipeline_depth_write_);
+    cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *graphics_pipeline_layout_, {*instances});
+
+    VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
+    vkCmdSetViewport(cb, 0, 1, &viewport);
+    VkRect2D scissor = {0, 0, width, height};
+    vkCmdSetScissor(cb, 0, 1, &scissor);
+
+    vkCmdDrawIndirect(cb, *draw_indirect, draw_indirect_offset, 1, 0);
+
+    vkCmdEndRendering(cb);
+
+    // Update depth attachment to load existing values for transparency pass
+    depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    // Clear color for transparency pass
+    color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+  }
+
+  // Now render with transparency pipeline (depth writing disabled) for final image
+  vkCmdBeginRendering(cb, &rendering_info);
+
+  vkCmdPushConstants(cb, *graphics_pipeline_layout_, VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+                     sizeof(graphics_push_constants), &graphics_push_constants);
+
+  // Always use transparency pipeline (depth writing disabled) for proper alpha blending
+  vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *splat_pipeline_);
+  cmdPushDescriptorSet(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *graphics_pipeline_layout_, {*instances});
+
+  VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
+  vkCmdSetViewport(cb, 0, 1, &viewport);
+  VkRect2D scissor = {0, 0, width, height};
+  vkCmdSetScissor(cb, 0, 1, &scissor);
+
+  vkCmdDrawIndirect(cb, *draw_indirect, draw_indirect_offset, 1, 0);
+
+  vkCmdBindPipeline(cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *splat_background_pipeline_);
+  vkCmdDraw(cb, 3, 1, 0, 0);
+
+  vkCmdEndRendering(cb);
+}
+
+std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> splats, const DrawOptions& draw_options,
+                                              uint8_t* dst) {
+  std::lock_guard<std::mutex> lock(*mutex_);
+
+  std::shared_ptr<RenderedImage> rendered_image;
+
+  uint32_t width = draw_options.width;
+  uint32_t height = draw_options.height;
+
+  auto cq = device_->compute_queue();
+  auto gq = device_->graphics_queue();
+  auto tq = device_->transfer_queue();
+
+  if (MakeResident(splats)) {
+    residency_manager_->AddMiss();
+  } else {
+    residency_manager_->AddHit();
+  }
+
+  auto N = splats->size();
+  auto position = splats->position();
+  auto cov3d = splats->cov3d();
+  auto sh = splats->sh();
+  // Opacity is in position for interleaved splats, binding it again where the pipelines do not read it.
+  auto opacity = splats->interleaved() ? position : splats->opacity();
+  auto chunk = splats->chunk();
+  auto sh_codebook = splats->sh_codebook();
 
   // Update storages
-  const auto& double_buffer = double_buffer_[frame_index_ % 2];
-  auto compute_storage = double_buffer.compute_storage;
-  auto graphics_storage = double_buffer.graphics_storage;
-  auto transfer_storage = double_buffer.transfer_storage;
-  auto csem = double_buffer.compute_semaphore;
+  const auto& frame = frames_[frame_index_ % frames_.size()];
+  // Compute scratch returns to the pool with the graphics task, the last to read it.
+  auto compute_storage = scratch_pool_->Acquire(N, *sorter_);
+  auto graphics_storage = frame.graphics_storage;
+  auto transfer_storage = frame.transfer_storage;
+  auto csem = frame.compute_semaphore;
   auto cval = csem->value();
-  auto gsem = double_buffer.graphics_semaphore;
+  auto gsem = frame.graphics_semaphore;
   auto gval = gsem->value();
-  auto tsem = double_buffer.transfer_semaphore;
+  auto tsem = frame.transfer_semaphore;
   auto tval = tsem->value();
 
-  compute_storage->Update(N, sorter_->GetStorageRequirements(N));
   graphics_storage->Update(width, height);
   transfer_storage->Update(width, height);
 
@@ -820,10 +2559,9 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
   auto inverse_index = compute_storage->inverse_index();
   auto camera = compute_storage->camera();
   auto draw_indirect = compute_storage->draw_indirect();
+  auto dispatch_indirect = compute_storage->dispatch_indirect();
   auto instances = compute_storage->instances();
-  auto camera_stage = compute_storage->camera_stage();
-
-  std::memcpy(camera_stage->data(), &camera_data, sizeof(Camera));
+  auto camera_stage = upload_ring_->buffer();
 
   auto image = graphics_storage->image();
   auto image_u8 = graphics_storage->image_u8();
@@ -843,95 +2581,8 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(*cb, &begin_info);
 
-    VkBufferCopy region = {0, 0, sizeof(Camera)};
-    vkCmdCopyBuffer(*cb, *camera_stage, *camera, 1, &region);
-    vkCmdFillBuffer(*cb, *visible_point_count, 0, sizeof(uint32_t), 0);
-    vkCmdFillBuffer(*cb, *inverse_index, 0, N * sizeof(uint32_t), -1);
-
-    VkMemoryBarrier2 memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
-    memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    memory_barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
-    VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    dependency_info.memoryBarrierCount = 1;
-    dependency_info.pMemoryBarriers = &memory_barrier;
-    vkCmdPipelineBarrier2(*cb, &dependency_info);
-
-    // Rank
-    cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
-                         {
-                             *camera,
-                             *position,
-                             *visible_point_count,
-                             *key,
-                             *index,
-                         });
-    vkCmdPushConstants(*cb, *compute_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(compute_push_constants),
-                       &compute_push_constants);
-    vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *rank_pipeline_);
-    vkCmdDispatch(*cb, WorkgroupSize(N, 256), 1, 1);
-
-    // Sort
-    memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
-    memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    memory_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
-    memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT;
-    dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    dependency_info.memoryBarrierCount = 1;
-    dependency_info.pMemoryBarriers = &memory_barrier;
-    vkCmdPipelineBarrier2(*cb, &dependency_info);
-
-    sorter_->SortKeyValueIndirect(*cb, N, *visible_point_count, *key, *index, *sort_storage);
-
-    // Inverse index
-    memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
-    memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    memory_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
-    memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
-    dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    dependency_info.memoryBarrierCount = 1;
-    dependency_info.pMemoryBarriers = &memory_barrier;
-    vkCmdPipelineBarrier2(*cb, &dependency_info);
-
-    cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
-                         {
-                             *visible_point_count,
-                             *index,
-                             *inverse_index,
-                         });
-    vkCmdPushConstants(*cb, *compute_pipeline_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(compute_push_constants),
-                       &compute_push_constants);
-    vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *inverse_index_pipeline_);
-    vkCmdDispatch(*cb, WorkgroupSize(N, 256), 1, 1);
-
-    // Projection
-    memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
-    memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    memory_barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
-    memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
-    memory_barrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
-    dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    dependency_info.memoryBarrierCount = 1;
-    dependency_info.pMemoryBarriers = &memory_barrier;
-    vkCmdPipelineBarrier2(*cb, &dependency_info);
-
-    cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *compute_pipeline_layout_,
-                         {
-                             *camera,
-                             *position,
-                             *cov3d,
-                             *opacity,
-                             *sh,
-                             *visible_point_count,
-                             *inverse_index,
-                             *draw_indirect,
-                             *instances,
-                         });
-    vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_COMPUTE, *projection_pipeline_);
-    vkCmdDispatch(*cb, WorkgroupSize(N, 256), 1, 1);
+    auto rank_queries = gpu_timer_->Begin(*cb);
+    RecordProjection(*cb, splats, &draw_options, 1, *compute_storage, rank_queries.get());
 
     // Release
     std::vector<VkBufferMemoryBarrier2> buffer_memory_barriers(2);
@@ -951,7 +2602,7 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     buffer_memory_barriers[1].buffer = *draw_indirect;
     buffer_memory_barriers[1].offset = 0;
     buffer_memory_barriers[1].size = VK_WHOLE_SIZE;
-    dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+    VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
     dependency_info.bufferMemoryBarrierCount = buffer_memory_barriers.size();
     dependency_info.pBufferMemoryBarriers = buffer_memory_barriers.data();
     vkCmdPipelineBarrier2(*cb, &dependency_info);
@@ -960,8 +2611,8 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
 
     // Submit
     std::vector<VkSemaphoreSubmitInfo> wait_semaphore_infos;
-    if (frame_index_ >= 2) {
-      // G[i-2].read before C[i].comp
+    if (frame_index_ >= frames_.size()) {
+      // G[i-F].read before C[i].comp, for F frames in flight
       auto& wait_semaphore_info = wait_semaphore_infos.emplace_back();
       wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
       wait_semaphore_info.semaphore = *gsem;
@@ -986,8 +2637,14 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     submit_info.pSignalSemaphoreInfos = &signal_semaphore_info;
 
     vkQueueSubmit2(*cq, 1, &submit_info, *fence);
-    task_monitor_->Add(fence, {cb, csem, camera_stage, camera, position, cov3d, opacity, sh, visible_point_count, key,
-                               index, sort_storage, inverse_index, draw_indirect, instances});
+    std::vector<std::shared_ptr<gpu::Object>> objects = {cb, csem, camera_stage, camera, position, cov3d, opacity, sh,
+                                                         visible_point_count, key, index, sort_storage,
+                                                         inverse_index, draw_indirect, dispatch_indirect, instances};
+    if (chunk) objects.push_back(chunk);
+    if (sh_codebook) objects.push_back(sh_codebook);
+    std::function<void()> resolve;
+    if (rank_queries) resolve = [gpu_timer = gpu_timer_, rank_queries] { gpu_timer->ResolveRank(rank_queries); };
+    upload_ring_->Submit(task_monitor_->Add(fence, objects, resolve));
   }
 
   // Graphics queue
@@ -1022,102 +2679,7 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     dependency_info.pBufferMemoryBarriers = buffer_memory_barriers.data();
     vkCmdPipelineBarrier2(*cb, &dependency_info);
 
-    // Layout transition to color attachment
-    VkImageMemoryBarrier2 image_memory_barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
-    image_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
-    image_memory_barrier.dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
-    image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    image_memory_barrier.image = *image;
-    image_memory_barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
-
-    // Layout transition for depth attachment
-    VkImageMemoryBarrier2 depth_memory_barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
-    depth_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
-    depth_memory_barrier.dstAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    depth_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    depth_memory_barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
-    depth_memory_barrier.image = *depth_image;
-    depth_memory_barrier.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
-
-    std::array<VkImageMemoryBarrier2, 2> image_barriers = {image_memory_barrier, depth_memory_barrier};
-    dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
-    dependency_info.imageMemoryBarrierCount = image_barriers.size();
-    dependency_info.pImageMemoryBarriers = image_barriers.data();
-    vkCmdPipelineBarrier2(*cb, &dependency_info);
-
-    // Rendering
-    VkRenderingAttachmentInfo color_attachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO};
-    color_attachment.imageView = image->image_view();
-    color_attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    color_attachment.clearValue.color = {0.f, 0.f, 0.f, 0.f};
-
-    VkRenderingAttachmentInfo depth_attachment = {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO};
-    depth_attachment.imageView = depth_image->image_view();
-    depth_attachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
-    depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    depth_attachment.clearValue.depthStencil.depth = 1.0f;
-
-    VkRenderingInfo rendering_info = {VK_STRUCTURE_TYPE_RENDERING_INFO};
-    rendering_info.renderArea.offset = {0, 0};
-    rendering_info.renderArea.extent = {width, height};
-    rendering_info.layerCount = 1;
-    rendering_info.colorAttachmentCount = 1;
-    rendering_info.pColorAttachments = &color_attachment;
-    rendering_info.pDepthAttachment = &depth_attachment;
-
-    // If auto-range is enabled, first render with depth writing to populate depth buffer
-    if (draw_options.depth_auto_range && draw_options.depth_z_min_out && draw_options.depth_z_max_out) {
-      vkCmdBeginRendering(*cb, &rendering_info);
-
-      vkCmdPushConstants(*cb, *graphics_pipeline_layout_, VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                         sizeof(graphics_push_constants), &graphics_push_constants);
-
-      // Use depth-write pipeline to populate depth buffer
-      vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *splat_pipeline_depth_write_);
-      cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *graphics_pipeline_layout_, {*instances});
-
-      VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
-      vkCmdSetViewport(*cb, 0, 1, &viewport);
-      VkRect2D scissor = {0, 0, width, height};
-      vkCmdSetScissor(*cb, 0, 1, &scissor);
-
-      vkCmdBindIndexBuffer(*cb, *index_buffer, 0, VK_INDEX_TYPE_UINT32);
-      vkCmdDrawIndexedIndirect(*cb, *draw_indirect, 0, 1, 0);
-
-      vkCmdEndRendering(*cb);
-
-      // Update depth attachment to load existing values for transparency pass
-      depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
-      // Clear color for transparency pass
-      color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    }
-
-    // Now render with transparency pipeline (depth writing disabled) for final image
-    vkCmdBeginRendering(*cb, &rendering_info);
-
-    vkCmdPushConstants(*cb, *graphics_pipeline_layout_, VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                       sizeof(graphics_push_constants), &graphics_push_constants);
-
-    // Always use transparency pipeline (depth writing disabled) for proper alpha blending
-    vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *splat_pipeline_);
-    cmdPushDescriptorSet(*cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *graphics_pipeline_layout_, {*instances});
-
-    VkViewport viewport = {0.f, 0.f, static_cast<float>(width), static_cast<float>(height), 0.f, 1.f};
-    vkCmdSetViewport(*cb, 0, 1, &viewport);
-    VkRect2D scissor = {0, 0, width, height};
-    vkCmdSetScissor(*cb, 0, 1, &scissor);
-
-    vkCmdBindIndexBuffer(*cb, *index_buffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexedIndirect(*cb, *draw_indirect, 0, 1, 0);
-
-    vkCmdBindPipeline(*cb, VK_PIPELINE_BIND_POINT_GRAPHICS, *splat_background_pipeline_);
-    vkCmdDraw(*cb, 3, 1, 0, 0);
-
-    vkCmdEndRendering(*cb);
+    RecordSplats(*cb, draw_options, *graphics_storage, *compute_storage, 0);
 
     // Release depth image to transfer queue if auto-range is enabled
     std::vector<VkImageMemoryBarrier2> release_barriers;
@@ -1137,7 +2699,7 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     }
 
     // float -> uint8
-    image_memory_barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+    VkImageMemoryBarrier2 image_memory_barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
     image_memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
     image_memory_barrier.srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
     image_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_BLIT_BIT;
@@ -1202,11 +2764,10 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     wait_semaphore_infos[0] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
     wait_semaphore_infos[0].semaphore = *csem;
     wait_semaphore_infos[0].value = cval + 1;
-    wait_semaphore_infos[0].stageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
-                                        VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+    wait_semaphore_infos[0].stageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
 
-    if (frame_index_ >= 2) {
-      // T[i-2].xfer before G[i].output
+    if (frame_index_ >= frames_.size()) {
+      // T[i-F].xfer before G[i].output
       auto& wait_semaphore_info = wait_semaphore_infos.emplace_back();
       wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
       wait_semaphore_info.semaphore = *tsem;
@@ -1222,8 +2783,7 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     signal_semaphore_infos[0] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
     signal_semaphore_infos[0].semaphore = *gsem;
     signal_semaphore_infos[0].value = gval + 1;
-    signal_semaphore_infos[0].stageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
-                                          VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+    signal_semaphore_infos[0].stageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
 
     // G[i].blit
     signal_semaphore_infos[1] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
@@ -1240,13 +2800,13 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
     submit_info.pSignalSemaphoreInfos = signal_semaphore_infos.data();
 
     vkQueueSubmit2(*gq, 1, &submit_info, *fence);
-    task_monitor_->Add(fence, {cb, image, instances, index_buffer, draw_indirect, gsem});
+    scratch_pool_->Release(compute_storage, task_monitor_->Add(fence, {cb, image, instances, draw_indirect, gsem}));
   }
 
-  auto image_buffer = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT, width * height * 4, true);
+  auto image_buffer = readback_pool_->Acquire(width * height * 4);
   std::shared_ptr<gpu::Buffer> depth_buffer;
   if (draw_options.depth_auto_range && draw_options.depth_z_min_out && draw_options.depth_z_max_out) {
-    depth_buffer = gpu::Buffer::Create(device_, VK_BUFFER_USAGE_TRANSFER_DST_BIT, width * height * sizeof(float), true);
+    depth_buffer = readback_pool_->Acquire(width * height * sizeof(float));
   }
   {
     auto fence = device_->AllocateFence();
@@ -1402,6 +2962,9 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
       }
     });
 
+    readback_pool_->Release(image_buffer, task);
+    if (depth_buffer) readback_pool_->Release(depth_buffer, task);
+
     rendered_image = std::make_shared<RenderedImage>(width, height, task);
   }
 
@@ -1414,5 +2977,307 @@ std::shared_ptr<RenderedImage> Renderer::Draw(std::shared_ptr<GaussianSplats> sp
   return rendered_image;
 }
 
+std::shared_ptr<RenderedImage> Renderer::DrawBatch(std::shared_ptr<GaussianSplats> splats,
+                                                   const std::vector<DrawOptions>& draw_options, uint8_t* dst) {
+  if (draw_options.empty()) return std::make_shared<RenderedImage>(0, 0, nullptr);
+
+  uint32_t width = draw_options[0].width;
+  uint32_t height = draw_options[0].height;
+  if (width == 0 || height == 0) throw std::runtime_error("Invalid dimensions");
+  for (const auto& options : draw_options) {
+    if (options.width != width || options.height != height) {
+      throw std::runtime_error("All views of a batch must have the same size");
+    }
+    if (options.depth_auto_range) throw std::runtime_error("Depth auto-range is not supported by DrawBatch");
+  }
+
+  std::lock_guard<std::mutex> lock(*mutex_);
+
+  auto cq = device_->compute_queue();
+  auto gq = device_->graphics_queue();
+
+  if (MakeResident(splats)) {
+    residency_manager_->AddMiss();
+  } else {
+    residency_manager_->AddHit();
+  }
+
+  auto N = splats->size();
+  auto position = splats->position();
+  auto cov3d = splats->cov3d();
+  auto sh = splats->sh();
+  auto opacity = splats->interleaved() ? position : splats->opacity();
+  auto chunk = splats->chunk();
+  auto sh_codebook = splats->sh_codebook();
+  uint64_t image_size = static_cast<uint64_t>(width) * height * 4;
+
+  std::vector<std::shared_ptr<gpu::Task>> tasks;
+  for (size_t first = 0; first < draw_options.size();) {
+    // Consecutive views sharing projection options are ranked and sorted together in one storage, as many as fit in
+    // kBatchScratchSize and in 32-bit instance indices.
+    uint32_t view_count = 1;
+    while (view_count < kMaxViewCount && first + view_count < draw_options.size()) {
+      const auto& options = draw_options[first + view_count];
+      uint64_t instance_count = static_cast<uint64_t>(view_count + 1) * N;
+      if (options.eps2d != draw_options[first].eps2d || options.sh_degree != draw_options[first].sh_degree ||
+          options.sorted_projection != draw_options[first].sorted_projection ||
+          instance_count > std::numeric_limits<uint32_t>::max() ||
+          ComputeStorage::ScratchSize(instance_count, sorter_->GetStorageRequirements(instance_count)) >
+              kBatchScratchSize) {
+        break;
+      }
+      view_count++;
+    }
+    auto compute_storage = scratch_pool_->Acquire(view_count * N, *sorter_);
+
+    const auto& frame = frames_[frame_index_ % frames_.size()];
+    auto graphics_storage = frame.graphics_storage;
+    auto csem = frame.compute_semaphore;
+    auto cval = csem->value();
+    auto gsem = frame.graphics_semaphore;
+    auto gval = gsem->value();
+    auto tsem = frame.transfer_semaphore;
+    auto tval = tsem->value();
+
+    graphics_storage->Update(width, height);
+    auto image = graphics_storage->image();
+    auto image_u8 = graphics_storage->image_u8();
+    auto depth_image = graphics_storage->depth_image();
+    auto camera_stage = upload_ring_->buffer();
+
+    std::vector<std::shared_ptr<gpu::Buffer>> scratch_buffers = {compute_storage->instances(),
+                                                                 compute_storage->draw_indirect()};
+
+    // Compute queue: all views of the chunk at once, then release of their instances and draw commands.
+    {
+      auto fence = device_->AllocateFence();
+      auto cb = cq->AllocateCommandBuffer();
+
+      VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+      begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+      vkBeginCommandBuffer(*cb, &begin_info);
+
+      auto rank_queries = gpu_timer_->Begin(*cb);
+      RecordProjection(*cb, splats, &draw_options[first], view_count, *compute_storage, rank_queries.get());
+
+      std::vector<VkBufferMemoryBarrier2> buffer_memory_barriers;
+      for (const auto& buffer : scratch_buffers) {
+        auto& barrier = buffer_memory_barriers.emplace_back();
+        barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+        barrier.srcQueueFamilyIndex = cq->family_index();
+        barrier.dstQueueFamilyIndex = gq->family_index();
+        barrier.buffer = *buffer;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+      }
+      VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+      dependency_info.bufferMemoryBarrierCount = buffer_memory_barriers.size();
+      dependency_info.pBufferMemoryBarriers = buffer_memory_barriers.data();
+      vkCmdPipelineBarrier2(*cb, &dependency_info);
+
+      vkEndCommandBuffer(*cb);
+
+      // Scratch from the pool is idle, so unlike Draw there is no wait on earlier graphics work.
+      VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+      command_buffer_info.commandBuffer = *cb;
+
+      VkSemaphoreSubmitInfo signal_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      signal_semaphore_info.semaphore = *csem;
+      signal_semaphore_info.value = cval + 1;
+      signal_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+      VkSubmitInfo2 submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+      submit_info.commandBufferInfoCount = 1;
+      submit_info.pCommandBufferInfos = &command_buffer_info;
+      submit_info.signalSemaphoreInfoCount = 1;
+      submit_info.pSignalSemaphoreInfos = &signal_semaphore_info;
+
+      vkQueueSubmit2(*cq, 1, &submit_info, *fence);
+      std::vector<std::shared_ptr<gpu::Object>> objects = {cb, csem, camera_stage, position, cov3d, opacity, sh};
+      if (chunk) objects.push_back(chunk);
+      if (sh_codebook) objects.push_back(sh_codebook);
+      objects.insert(objects.end(), scratch_buffers.begin(), scratch_buffers.end());
+      std::function<void()> resolve;
+      if (rank_queries) resolve = [gpu_timer = gpu_timer_, rank_queries] { gpu_timer->ResolveRank(rank_queries); };
+      upload_ring_->Submit(task_monitor_->Add(fence, objects, resolve));
+    }
+
+    // Graphics queue: draws of all views into the same images, each read back to its range of image_buffer.
+    auto image_buffer = readback_pool_->Acquire(view_count * image_size);
+    {
+      auto fence = device_->AllocateFence();
+      auto cb = gq->AllocateCommandBuffer();
+
+      VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+      begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+      vkBeginCommandBuffer(*cb, &begin_info);
+
+      // Acquire
+      std::vector<VkBufferMemoryBarrier2> buffer_memory_barriers;
+      for (size_t i = 0; i < scratch_buffers.size(); ++i) {
+        bool indirect = i == 1;
+        auto& barrier = buffer_memory_barriers.emplace_back();
+        barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2};
+        barrier.dstStageMask = indirect ? VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT : VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+        barrier.dstAccessMask = indirect ? VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT : VK_ACCESS_2_SHADER_READ_BIT;
+        barrier.srcQueueFamilyIndex = cq->family_index();
+        barrier.dstQueueFamilyIndex = gq->family_index();
+        barrier.buffer = *scratch_buffers[i];
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+      }
+      VkDependencyInfo dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+      dependency_info.bufferMemoryBarrierCount = buffer_memory_barriers.size();
+      dependency_info.pBufferMemoryBarriers = buffer_memory_barriers.data();
+      vkCmdPipelineBarrier2(*cb, &dependency_info);
+
+      for (uint32_t i = 0; i < view_count; ++i) {
+        if (i > 0) {
+          // The previous view is done with the images before they are drawn again.
+          VkMemoryBarrier2 memory_barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+          memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+          memory_barrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
+          memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+          memory_barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+          dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+          dependency_info.memoryBarrierCount = 1;
+          dependency_info.pMemoryBarriers = &memory_barrier;
+          vkCmdPipelineBarrier2(*cb, &dependency_info);
+        }
+
+        RecordSplats(*cb, draw_options[first + i], *graphics_storage, *compute_storage, i);
+
+        // float -> uint8
+        std::array<VkImageMemoryBarrier2, 2> image_memory_barriers;
+        image_memory_barriers[0] = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+        image_memory_barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+        image_memory_barriers[0].srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT;
+        image_memory_barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_BLIT_BIT;
+        image_memory_barriers[0].dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+        image_memory_barriers[0].oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        image_memory_barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image_memory_barriers[0].image = *image;
+        image_memory_barriers[0].subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        image_memory_barriers[1] = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+        image_memory_barriers[1].srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        image_memory_barriers[1].srcAccessMask = 0;
+        image_memory_barriers[1].dstStageMask = VK_PIPELINE_STAGE_2_BLIT_BIT;
+        image_memory_barriers[1].dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        image_memory_barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image_memory_barriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        image_memory_barriers[1].image = *image_u8;
+        image_memory_barriers[1].subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+        dependency_info.imageMemoryBarrierCount = image_memory_barriers.size();
+        dependency_info.pImageMemoryBarriers = image_memory_barriers.data();
+        vkCmdPipelineBarrier2(*cb, &dependency_info);
+
+        VkImageBlit image_region = {};
+        image_region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        image_region.srcOffsets[0] = {0, 0, 0};
+        image_region.srcOffsets[1] = {static_cast<int>(width), static_cast<int>(height), 1};
+        image_region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        image_region.dstOffsets[0] = {0, 0, 0};
+        image_region.dstOffsets[1] = {static_cast<int>(width), static_cast<int>(height), 1};
+        vkCmdBlitImage(*cb, *image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, *image_u8,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_region, VK_FILTER_NEAREST);
+
+        // Readback on the graphics queue, without an ownership transfer to the transfer queue.
+        VkImageMemoryBarrier2 image_memory_barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+        image_memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_BLIT_BIT;
+        image_memory_barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        image_memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        image_memory_barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+        image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        image_memory_barrier.image = *image_u8;
+        image_memory_barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        dependency_info = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+        dependency_info.imageMemoryBarrierCount = 1;
+        dependency_info.pImageMemoryBarriers = &image_memory_barrier;
+        vkCmdPipelineBarrier2(*cb, &dependency_info);
+
+        VkBufferImageCopy region;
+        region.bufferOffset = i * image_size;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {width, height, 1};
+        vkCmdCopyImageToBuffer(*cb, *image_u8, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, *image_buffer, 1, &region);
+      }
+
+      vkEndCommandBuffer(*cb);
+
+      // Submit
+      std::vector<VkSemaphoreSubmitInfo> wait_semaphore_infos(1);
+      // C[i].comp before G[i].read
+      wait_semaphore_infos[0] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      wait_semaphore_infos[0].semaphore = *csem;
+      wait_semaphore_infos[0].value = cval + 1;
+      wait_semaphore_infos[0].stageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+
+      if (frame_index_ >= frames_.size()) {
+        // T[i-F].xfer before G[i].output
+        auto& wait_semaphore_info = wait_semaphore_infos.emplace_back();
+        wait_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+        wait_semaphore_info.semaphore = *tsem;
+        wait_semaphore_info.value = tval - 1 + 1;
+        wait_semaphore_info.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+      }
+
+      VkCommandBufferSubmitInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
+      command_buffer_info.commandBuffer = *cb;
+
+      // G[i].read, G[i].blit and T[i].xfer at once, keeping the timelines of Draw.
+      std::vector<VkSemaphoreSubmitInfo> signal_semaphore_infos(3);
+      signal_semaphore_infos[0] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      signal_semaphore_infos[0].semaphore = *gsem;
+      signal_semaphore_infos[0].value = gval + 1;
+      signal_semaphore_infos[0].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+      signal_semaphore_infos[1] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      signal_semaphore_infos[1].semaphore = *gsem;
+      signal_semaphore_infos[1].value = gval + 2;
+      signal_semaphore_infos[1].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+      signal_semaphore_infos[2] = {VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+      signal_semaphore_infos[2].semaphore = *tsem;
+      signal_semaphore_infos[2].value = tval + 1;
+      signal_semaphore_infos[2].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+      VkSubmitInfo2 submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO_2};
+      submit_info.waitSemaphoreInfoCount = wait_semaphore_infos.size();
+      submit_info.pWaitSemaphoreInfos = wait_semaphore_infos.data();
+      submit_info.commandBufferInfoCount = 1;
+      submit_info.pCommandBufferInfos = &command_buffer_info;
+      submit_info.signalSemaphoreInfoCount = signal_semaphore_infos.size();
+      submit_info.pSignalSemaphoreInfos = signal_semaphore_infos.data();
+
+      vkQueueSubmit2(*gq, 1, &submit_info, *fence);
+      std::vector<std::shared_ptr<gpu::Object>> objects = {cb, image, image_u8, depth_image, gsem, tsem, image_buffer};
+      objects.insert(objects.end(), scratch_buffers.begin(), scratch_buffers.end());
+      auto chunk_dst = dst + first * image_size;
+      auto chunk_size = view_count * image_size;
+      auto task = task_monitor_->Add(fence, objects, [image_buffer, chunk_dst, chunk_size] {
+        std::memcpy(chunk_dst, image_buffer->data<uint8_t>(), chunk_size);
+      });
+      scratch_pool_->Release(compute_storage, task);
+      readback_pool_->Release(image_buffer, task);
+      tasks.push_back(task);
+    }
+
+    csem->Increment();
+    gsem->Increment();
+    gsem->Increment();
+    tsem->Increment();
+    frame_index_++;
+
+    first += view_count;
+  }
+
+  return std::make_shared<RenderedImage>(width, height, tasks);
+}
+
 }  // namespace core
 }  // namespace vkgs
@@ -0,0 +1,78 @@
+#include "residency_manager.h"
+
+#include "vkgs/core/gaussian_splats.h"
+
+namespace vkgs {
+namespace core {
+
+ResidencyManager::ResidencyManager() = default;
+
+ResidencyManager::~ResidencyManager() = default;
+
+void ResidencyManager::Touch(std::shared_ptr<GaussianSplats> splats) {
+  // A destroyed splats may leave an entry behind at the same address, which is replaced here.
+  auto& entry = entries_[splats.get()];
+  entry.splats = splats;
+  entry.last_used = ++clock_;
+}
+
+std::shared_ptr<GaussianSplats> ResidencyManager::LeastRecentlyUsed(const GaussianSplats* exclude) {
+  Prune();
+
+  std::shared_ptr<GaussianSplats> result;
+  uint64_t last_used = 0;
+  for (const auto& [ptr, entry] : entries_) {
+    if (ptr == exclude) continue;
+    auto splats = entry.splats.lock();
+    if (splats == nullptr || !splats->resident()) continue;
+    if (result == nullptr || entry.last_used < last_used) {
+      result = splats;
+      last_used = entry.last_used;
+    }
+  }
+  return result;
+}
+
+ResidencyStats ResidencyManager::stats() {
+  Prune();
+
+  ResidencyStats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  for (const auto& [ptr, entry] : entries_) {
+    auto splats = entry.splats.lock();
+    if (splats == nullptr) continue;
+    if (splats->resident()) {
+      stats.resident_count++;
+      stats.resident_size += splats->device_size();
+    } else {
+      stats.evicted_count++;
+      stats.evicted_size += splats->device_size();
+    }
+  }
+  return stats;
+}
+
+uint64_t ResidencyManager::resident_size() { return stats().resident_size; }
+
+std::vector<std::shared_ptr<GaussianSplats>> ResidencyManager::splats() {
+  std::vector<std::shared_ptr<GaussianSplats>> result;
+  for (const auto& [ptr, entry] : entries_) {
+    if (auto splats = entry.splats.lock()) result.push_back(splats);
+  }
+  return result;
+}
+
+void ResidencyManager::Prune() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.splats.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace vkgs
@@ -0,0 +1,58 @@
+#ifndef VKGS_CORE_RESIDENCY_MANAGER_H
+#define VKGS_CORE_RESIDENCY_MANAGER_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "vkgs/core/residency_stats.h"
+
+namespace vkgs {
+namespace core {
+
+class GaussianSplats;
+
+// Tracks live GaussianSplats in order of last use. Not thread-safe, guarded by the renderer mutex.
+class ResidencyManager {
+ public:
+  ResidencyManager();
+  ~ResidencyManager();
+
+  // Starts tracking splats, or marks them as the most recently used.
+  void Touch(std::shared_ptr<GaussianSplats> splats);
+
+  // Least recently used resident splats other than exclude, or nullptr.
+  std::shared_ptr<GaussianSplats> LeastRecentlyUsed(const GaussianSplats* exclude);
+
+  // Counters are updated by the renderer, sizes are computed from the tracked splats.
+  ResidencyStats stats();
+  uint64_t resident_size();
+
+  // Live tracked splats.
+  std::vector<std::shared_ptr<GaussianSplats>> splats();
+
+  void AddHit() noexcept { hits_++; }
+  void AddMiss() noexcept { misses_++; }
+  void AddEviction() noexcept { evictions_++; }
+
+ private:
+  struct Entry {
+    std::weak_ptr<GaussianSplats> splats;
+    uint64_t last_used = 0;
+  };
+
+  // Drops entries of destroyed splats.
+  void Prune();
+
+  std::unordered_map<const GaussianSplats*, Entry> entries_;
+  uint64_t clock_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_RESIDENCY_MANAGER_H
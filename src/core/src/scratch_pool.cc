@@ -0,0 +1,85 @@
+#include "scratch_pool.h"
+
+#include <algorithm>
+
+#include "vkgs/gpu/task.h"
+
+#include "compute_storage.h"
+#include "sorter.h"
+
+namespace vkgs {
+namespace core {
+namespace {
+
+// The high-water mark loses 1/64 of its excess over each draw, so about 300 smaller draws cut the excess 100-fold.
+constexpr uint64_t kHighWaterDecay = 64;
+
+// Free storages over this multiple of the high-water mark are released.
+constexpr uint64_t kShrinkFactor = 2;
+
+}  // namespace
+
+ScratchPool::ScratchPool(std::shared_ptr<gpu::Device> device)
+    : device_(device), queue_mutex_(std::make_shared<std::mutex>()) {}
+
+ScratchPool::~ScratchPool() = default;
+
+std::shared_ptr<ComputeStorage> ScratchPool::Acquire(uint32_t point_count, const Sorter& sorter) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Reclaim();
+
+  if (point_count >= high_water_) {
+    high_water_ = point_count;
+  } else {
+    high_water_ -= (high_water_ - point_count) / kHighWaterDecay;
+  }
+
+  // Oversized storages are released, the rest are kept for later draws.
+  free_.erase(std::remove_if(free_.begin(), free_.end(),
+                             [this](const auto& storage) { return storage->capacity() > kShrinkFactor * high_water_; }),
+              free_.end());
+
+  // The smallest free storage that fits.
+  auto best = free_.end();
+  for (auto it = free_.begin(); it != free_.end(); ++it) {
+    if ((*it)->capacity() >= point_count && (best == free_.end() || (*it)->capacity() < (*best)->capacity())) best = it;
+  }
+  if (best != free_.end()) {
+    auto storage = *best;
+    free_.erase(best);
+    return storage;
+  }
+
+  // Sized to the high-water mark so that draws up to recent sizes reuse it.
+  auto storage = std::make_shared<ComputeStorage>(device_);
+  storage->Update(high_water_, sorter.GetStorageRequirements(high_water_));
+  return storage;
+}
+
+void ScratchPool::Release(std::shared_ptr<ComputeStorage> storage, std::shared_ptr<gpu::Task> task) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  in_flight_.push_back({storage, task});
+}
+
+uint64_t ScratchPool::UnaliasedSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t size = 0;
+  for (const auto& storage : free_) size += storage->unaliased_scratch_size();
+  for (const auto& in_flight : in_flight_) size += in_flight.storage->unaliased_scratch_size();
+  return size;
+}
+
+void ScratchPool::Reclaim() {
+  for (size_t i = 0; i < in_flight_.size();) {
+    if (in_flight_[i].task->IsDone()) {
+      free_.push_back(in_flight_[i].storage);
+      std::swap(in_flight_[i], in_flight_.back());
+      in_flight_.pop_back();
+    } else {
+      ++i;
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace vkgs
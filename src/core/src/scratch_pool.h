@@ -0,0 +1,61 @@
+#ifndef VKGS_CORE_SCRATCH_POOL_H
+#define VKGS_CORE_SCRATCH_POOL_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vkgs {
+namespace gpu {
+
+class Device;
+class Task;
+
+}  // namespace gpu
+
+namespace core {
+
+class ComputeStorage;
+class Sorter;
+
+// Per-frame compute scratch of the renderers on a device. A storage is acquired by a draw and returns to the pool once
+// the task of its last use is done. Storages are sized to a high-water mark of recent draws that decays over draws
+// of fewer points, and free storages much larger than the mark are released. Thread-safe, shared by renderers created
+// with Renderer(std::shared_ptr<ScratchPool>).
+class ScratchPool {
+ public:
+  explicit ScratchPool(std::shared_ptr<gpu::Device> device);
+  ~ScratchPool();
+
+  auto device() const noexcept { return device_; }
+  // Guards submission to the device queues, held by all renderers of the pool.
+  auto queue_mutex() const noexcept { return queue_mutex_; }
+
+  std::shared_ptr<ComputeStorage> Acquire(uint32_t point_count, const Sorter& sorter);
+  void Release(std::shared_ptr<ComputeStorage> storage, std::shared_ptr<gpu::Task> task);
+
+  // Bytes the free and in-flight storages would take without aliasing their buffers.
+  uint64_t UnaliasedSize();
+
+ private:
+  struct InFlight {
+    std::shared_ptr<ComputeStorage> storage;
+    std::shared_ptr<gpu::Task> task;
+  };
+
+  // Returns storages of done tasks to the free list.
+  void Reclaim();
+
+  std::shared_ptr<gpu::Device> device_;
+  std::shared_ptr<std::mutex> queue_mutex_;
+  std::mutex mutex_;
+  uint64_t high_water_ = 0;  // decaying maximum of recent point counts
+  std::vector<std::shared_ptr<ComputeStorage>> free_;
+  std::vector<InFlight> in_flight_;
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_SCRATCH_POOL_H
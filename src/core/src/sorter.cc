@@ -18,6 +18,10 @@ VrdxSorterStorageRequirements Sorter::GetStorageRequirements(size_t max_size) co
   return requirements;
 }
 
+void Sorter::SortKeyValue(VkCommandBuffer cb, size_t size, VkBuffer key, VkBuffer value, VkBuffer storage) const {
+  vrdxCmdSortKeyValue(cb, sorter_, size, key, 0, value, 0, storage, 0, VK_NULL_HANDLE, 0);
+}
+
 void Sorter::SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key, VkBuffer value,
                                   VkBuffer storage) const {
   vrdxCmdSortKeyValueIndirect(cb, sorter_, max_size, size, 0, key, 0, value, 0, storage, 0, VK_NULL_HANDLE, 0);
@@ -14,6 +14,7 @@ class Sorter {
   ~Sorter();
 
   VrdxSorterStorageRequirements GetStorageRequirements(size_t max_size) const;
+  void SortKeyValue(VkCommandBuffer cb, size_t size, VkBuffer key, VkBuffer value, VkBuffer storage) const;
   void SortKeyValueIndirect(VkCommandBuffer cb, size_t max_size, VkBuffer size, VkBuffer key, VkBuffer value,
                             VkBuffer storage) const;
 
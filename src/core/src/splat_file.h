@@ -0,0 +1,39 @@
+#ifndef VKGS_CORE_SPLAT_FILE_H
+#define VKGS_CORE_SPLAT_FILE_H
+
+#include <cstdint>
+
+namespace vkgs {
+namespace core {
+
+// Pre-parsed splat file (.vkgs), storing the GPU layout of GaussianSplats as is:
+//   [SplatFileHeader][position (N, 3) float][cov3d (N, 6) float][sh (N, K) f16vec4][opacity (N) float]
+// Sections start at kSplatFileAlignment-aligned byte offsets. All values are little-endian.
+constexpr char kSplatFileMagic[4] = {'V', 'K', 'G', 'S'};
+constexpr uint32_t kSplatFileVersion = 1;
+constexpr uint64_t kSplatFileAlignment = 256;
+
+enum SplatFileSection : uint32_t {
+  kSplatFilePosition = 0,
+  kSplatFileCov3d = 1,
+  kSplatFileSh = 2,
+  kSplatFileOpacity = 3,
+  kSplatFileSectionCount = 4,
+};
+
+struct SplatFileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t point_count;
+  uint32_t sh_degree;
+  uint32_t section_count;
+  struct {
+    uint64_t offset;  // byte offset from the beginning of the file
+    uint64_t size;    // byte size
+  } sections[kSplatFileSectionCount];
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_SPLAT_FILE_H
@@ -9,9 +9,32 @@
 namespace vkgs {
 namespace core {
 
+// Header of the parse_ply input buffer, followed by vertex data.
+// Per property index: pos(3), scale(3), rot(4), sh(48), opacity(1); offsets[59] is the vertex stride.
+struct PlyLayout {
+  uint32_t offsets[60];  // byte offset in a vertex
+  uint32_t types[60];    // PlyType
+  glm::vec2 quant[60];   // value = raw * quant.x + quant.y
+};
+
+// Header of the parse_compressed_ply input buffer, followed by data words: bounds, packed vertices and 8-bit SH.
+struct CompressedPlyLayout {
+  uint32_t vertex_offset;  // word offset of packed vertices in data
+  uint32_t sh_offset;      // word offset of 8-bit SH in data
+  uint32_t sh_stride;      // f_rest bytes per point
+  uint32_t pad;
+};
+
 struct ParsePushConstants {
   alignas(16) uint32_t point_count;
   uint32_t sh_degree;
+  uint32_t point_offset;
+};
+
+struct ShCodebookPushConstants {
+  alignas(16) uint32_t point_count;
+  uint32_t sh_degree;
+  uint32_t codebook_size;
 };
 
 struct ComputePushConstants {
@@ -20,6 +43,8 @@ struct ComputePushConstants {
   float eps2d;
   uint32_t sh_degree_data;
   uint32_t sh_degree_draw;
+  uint32_t view_count;
+  uint32_t sorted_order;
 };
 
 struct GraphicsPushConstants {
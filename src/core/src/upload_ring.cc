@@ -0,0 +1,74 @@
+#include "upload_ring.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "vkgs/gpu/buffer.h"
+#include "vkgs/gpu/task.h"
+
+#include "memory_tag.h"
+
+namespace vkgs {
+namespace core {
+namespace {
+
+// Satisfies minStorageBufferOffsetAlignment of all devices, so regions can also be bound as descriptors.
+constexpr uint64_t kUploadAlignment = 256;
+
+}  // namespace
+
+UploadRing::UploadRing(std::shared_ptr<gpu::Device> device, uint64_t size) {
+  buffer_ = gpu::Buffer::Create(device, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, size,
+                                true);
+  buffer_->set_tag(kMemoryTagStaging);
+}
+
+UploadRing::~UploadRing() = default;
+
+UploadRing::Allocation UploadRing::Allocate(uint64_t size) {
+  size = (size + kUploadAlignment - 1) / kUploadAlignment * kUploadAlignment;
+  uint64_t capacity = buffer_->size();
+  if (size > capacity) {
+    throw std::runtime_error("Upload of " + std::to_string(size) + " bytes exceeds the upload ring");
+  }
+
+  while (true) {
+    Reclaim();
+    if (regions_.empty()) {
+      regions_.push_back({0, size, nullptr});
+      return {0, buffer_->data<char>()};
+    }
+
+    // Free space is after the newest region up to the oldest one, wrapping around the end of the buffer.
+    const auto& front = regions_.front();
+    const auto& back = regions_.back();
+    uint64_t offset = back.end;
+    bool fits;
+    if (back.begin >= front.begin) {
+      if (offset + size > capacity) offset = 0;
+      fits = offset != 0 || size <= front.begin;
+    } else {
+      fits = offset + size <= front.begin;
+    }
+    if (fits) {
+      regions_.push_back({offset, offset + size, nullptr});
+      return {offset, buffer_->data<char>() + offset};
+    }
+
+    if (front.task == nullptr) {
+      throw std::runtime_error("Upload ring is full of regions not yet submitted");
+    }
+    front.task->Wait();
+  }
+}
+
+void UploadRing::Submit(std::shared_ptr<gpu::Task> task) {
+  for (auto it = regions_.rbegin(); it != regions_.rend() && it->task == nullptr; ++it) it->task = task;
+}
+
+void UploadRing::Reclaim() {
+  while (!regions_.empty() && regions_.front().task && regions_.front().task->IsDone()) regions_.pop_front();
+}
+
+}  // namespace core
+}  // namespace vkgs
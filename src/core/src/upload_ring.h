@@ -0,0 +1,58 @@
+#ifndef VKGS_CORE_UPLOAD_RING_H
+#define VKGS_CORE_UPLOAD_RING_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+namespace vkgs {
+namespace gpu {
+
+class Device;
+class Buffer;
+class Task;
+
+}  // namespace gpu
+
+namespace core {
+
+// Persistently mapped host buffer handing out small upload regions, such as camera and constants, in submission order.
+// Regions are reused once the task of the submission reading them is done. Not thread-safe, guarded by the renderer
+// mutex.
+class UploadRing {
+ public:
+  struct Allocation {
+    uint64_t offset;  // byte offset in buffer()
+    void* data;
+  };
+
+  UploadRing(std::shared_ptr<gpu::Device> device, uint64_t size);
+  ~UploadRing();
+
+  auto buffer() const noexcept { return buffer_; }
+
+  // Waits for the oldest submissions if the ring is full. Throws if size does not fit next to the regions not yet
+  // submitted.
+  Allocation Allocate(uint64_t size);
+
+  // Regions allocated since the last Submit are read by task.
+  void Submit(std::shared_ptr<gpu::Task> task);
+
+ private:
+  struct Region {
+    uint64_t begin;
+    uint64_t end;
+    std::shared_ptr<gpu::Task> task;  // null until submitted
+  };
+
+  // Drops regions at the front whose tasks are done.
+  void Reclaim();
+
+  std::shared_ptr<gpu::Buffer> buffer_;
+  std::deque<Region> regions_;
+};
+
+}  // namespace core
+}  // namespace vkgs
+
+#endif  // VKGS_CORE_UPLOAD_RING_H
@@ -20,6 +20,18 @@ class VKGS_GPU_API Buffer : public Object {
   static std::shared_ptr<Buffer> Create(std::shared_ptr<Device> device, VkBufferUsageFlags usage, VkDeviceSize size,
                                         bool host = false);
 
+  // Wraps caller-owned host memory [ptr, ptr + size) as a buffer with VK_EXT_external_memory_host, without a copy.
+  // The import covers the enclosing aligned range; ptr is at offset() within the buffer. The buffer holds owner, which
+  // keeps the memory alive, and releases it after the import is freed. Returns nullptr if the device or the pointer
+  // does not support import.
+  static std::shared_ptr<Buffer> Import(std::shared_ptr<Device> device, VkBufferUsageFlags usage, const void* ptr,
+                                        VkDeviceSize size, std::shared_ptr<void> owner);
+
+  // Buffer bound to [offset, offset + size) of the memory of a device buffer created with Create, which it keeps
+  // alive. Buffers aliasing the same memory must not be in use at the same time.
+  static std::shared_ptr<Buffer> CreateAliased(std::shared_ptr<Buffer> memory, VkBufferUsageFlags usage,
+                                               VkDeviceSize offset, VkDeviceSize size);
+
  public:
   Buffer(std::shared_ptr<Device> device, VkBufferUsageFlags usage, VkDeviceSize size, bool host = false);
   ~Buffer() override;
@@ -27,6 +39,14 @@ class VKGS_GPU_API Buffer : public Object {
   operator VkBuffer() const noexcept { return buffer_; }
 
   VkDeviceSize size() const noexcept { return size_; }
+  VkDeviceSize offset() const noexcept { return offset_; }
+  bool host() const noexcept { return ptr_ != nullptr; }
+  // False for aliased and imported buffers, whose memory belongs to another buffer or to the caller.
+  bool owns_memory() const noexcept { return allocation_ != VK_NULL_HANDLE; }
+
+  // Moves the bytes of this buffer to tag in Device::tagged_memory, if it owns its memory.
+  uint32_t tag() const noexcept { return tag_; }
+  void set_tag(uint32_t tag) noexcept;
   void* data() noexcept { return ptr_; }
   const void* data() const noexcept { return ptr_; }
 
@@ -41,11 +61,18 @@ class VKGS_GPU_API Buffer : public Object {
   }
 
  private:
+  explicit Buffer(std::shared_ptr<Device> device);
+
   std::shared_ptr<Device> device_;
 
   VkDeviceSize size_ = 0;
+  VkDeviceSize offset_ = 0;
   VkBuffer buffer_ = VK_NULL_HANDLE;
   VmaAllocation allocation_ = VK_NULL_HANDLE;
+  VkDeviceMemory memory_ = VK_NULL_HANDLE;  // Imported memory, not owned by the allocator
+  std::shared_ptr<Buffer> aliased_;         // Owner of the memory of an aliased buffer
+  std::shared_ptr<void> owner_;             // Owner of the host memory of an imported buffer
+  uint32_t tag_ = 0;
   void* ptr_ = nullptr;
 };
 
@@ -1,6 +1,8 @@
 #ifndef VKGS_GPU_DEVICE_H
 #define VKGS_GPU_DEVICE_H
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -18,6 +20,9 @@ class Fence;
 class SemaphorePool;
 class FencePool;
 
+// Number of memory tags of buffers and images, see Buffer::set_tag. Tag 0 is untagged.
+constexpr uint32_t kMemoryTagCount = 8;
+
 class VKGS_GPU_API Device {
  public:
   Device();
@@ -39,6 +44,29 @@ class VKGS_GPU_API Device {
   auto compute_queue() const noexcept { return compute_queue_; }
   auto transfer_queue() const noexcept { return transfer_queue_; }
 
+  // VK_EXT_external_memory_host support, see Buffer::Import.
+  bool external_memory_host() const noexcept { return external_memory_host_; }
+  VkDeviceSize min_imported_host_pointer_alignment() const noexcept { return min_imported_host_pointer_alignment_; }
+
+  // Subgroup ballot operations in compute shaders.
+  bool subgroup_ballot() const noexcept { return subgroup_ballot_; }
+
+  // Valid bits of timestamps written on the compute queue, 0 if unsupported, and nanoseconds per timestamp tick.
+  uint32_t compute_timestamp_valid_bits() const noexcept { return compute_timestamp_valid_bits_; }
+  float timestamp_period() const noexcept { return timestamp_period_; }
+
+  // Usage and budget in bytes of device-local heaps, from VK_EXT_memory_budget if supported, otherwise estimated by
+  // VMA.
+  void GetDeviceLocalBudget(VkDeviceSize* usage, VkDeviceSize* budget) const;
+
+  // Bytes of all VMA allocations and of the memory blocks holding them, in device-local and other heaps.
+  void GetAllocatedMemory(VkDeviceSize* device_allocated, VkDeviceSize* device_reserved, VkDeviceSize* host_allocated,
+                          VkDeviceSize* host_reserved) const;
+
+  // Bytes of live buffers and images by memory tag, updated as they are created, tagged and destroyed.
+  void AddTaggedMemory(uint32_t tag, bool host, int64_t size) noexcept;
+  uint64_t tagged_memory(uint32_t tag, bool host) const noexcept;
+
   std::shared_ptr<Semaphore> AllocateSemaphore();
   std::shared_ptr<Fence> AllocateFence();
 
@@ -54,11 +82,21 @@ class VKGS_GPU_API Device {
 
   VmaAllocator allocator_ = VK_NULL_HANDLE;
 
+  bool external_memory_host_ = false;
+  VkDeviceSize min_imported_host_pointer_alignment_ = 0;
+  bool memory_budget_ = false;
+  bool subgroup_ballot_ = false;
+  uint32_t compute_timestamp_valid_bits_ = 0;
+  float timestamp_period_ = 0.f;
+
   std::shared_ptr<Queue> graphics_queue_;
   std::shared_ptr<Queue> compute_queue_;
   std::shared_ptr<Queue> transfer_queue_;
   std::shared_ptr<SemaphorePool> semaphore_pool_;
   std::shared_ptr<FencePool> fence_pool_;
+
+  std::array<std::atomic<uint64_t>, kMemoryTagCount> tagged_device_memory_ = {};
+  std::array<std::atomic<uint64_t>, kMemoryTagCount> tagged_host_memory_ = {};
 };
 
 }  // namespace gpu
@@ -21,14 +21,16 @@ class VKGS_GPU_API GraphicsPipeline : public Object {
                                                   const uint32_t (&fragment_shader)[M], VkFormat format,
                                                   VkFormat depth_format = VK_FORMAT_UNDEFINED,
                                                   bool depth_write_enable = false,
-                                                  VkCompareOp depth_compare_op = VK_COMPARE_OP_LESS) {
-    return std::make_shared<GraphicsPipeline>(device, pipeline_layout, vertex_shader, N, fragment_shader, M, format, depth_format, depth_write_enable, depth_compare_op);
+                                                  VkCompareOp depth_compare_op = VK_COMPARE_OP_LESS,
+                                                  VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST) {
+    return std::make_shared<GraphicsPipeline>(device, pipeline_layout, vertex_shader, N, fragment_shader, M, format, depth_format, depth_write_enable, depth_compare_op, topology);
   }
 
   GraphicsPipeline(VkDevice device, VkPipelineLayout pipeline_layout, const uint32_t* vertex_shader,
                    size_t vertex_shader_size, const uint32_t* fragment_shader, size_t fragment_shader_size,
                    VkFormat format, VkFormat depth_format = VK_FORMAT_UNDEFINED, bool depth_write_enable = false,
-                   VkCompareOp depth_compare_op = VK_COMPARE_OP_LESS);
+                   VkCompareOp depth_compare_op = VK_COMPARE_OP_LESS,
+                   VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
 
   ~GraphicsPipeline() override;
 
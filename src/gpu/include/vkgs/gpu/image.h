@@ -31,6 +31,11 @@ class VKGS_GPU_API Image : public Object {
   VkFormat format() const noexcept { return format_; }
   uint32_t width() const noexcept { return width_; }
   uint32_t height() const noexcept { return height_; }
+  VkDeviceSize size() const noexcept { return size_; }
+
+  // See Buffer::set_tag.
+  uint32_t tag() const noexcept { return tag_; }
+  void set_tag(uint32_t tag) noexcept;
 
  private:
   std::shared_ptr<Device> device_;
@@ -41,6 +46,8 @@ class VKGS_GPU_API Image : public Object {
   VkFormat format_;
   uint32_t width_;
   uint32_t height_;
+  VkDeviceSize size_ = 0;  // bytes of the allocation
+  uint32_t tag_ = 0;
 };
 
 }  // namespace gpu
@@ -0,0 +1,42 @@
+#ifndef VKGS_GPU_QUERY_POOL_H
+#define VKGS_GPU_QUERY_POOL_H
+
+#include "object.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "volk.h"
+
+#include "export_api.h"
+
+namespace vkgs {
+namespace gpu {
+
+class Device;
+
+// Timestamp queries, reset and written in command buffers.
+class VKGS_GPU_API QueryPool : public Object {
+ public:
+  static std::shared_ptr<QueryPool> Create(std::shared_ptr<Device> device, uint32_t count);
+
+ public:
+  QueryPool(std::shared_ptr<Device> device, uint32_t count);
+  ~QueryPool() override;
+
+  operator VkQueryPool() const noexcept { return query_pool_; }
+  uint32_t count() const noexcept { return count_; }
+
+  // Ticks of all timestamps, waiting until they are written.
+  void GetTimestamps(uint64_t* timestamps);
+
+ private:
+  std::shared_ptr<Device> device_;
+  VkQueryPool query_pool_ = VK_NULL_HANDLE;
+  uint32_t count_;
+};
+
+}  // namespace gpu
+}  // namespace vkgs
+
+#endif  // VKGS_GPU_QUERY_POOL_H
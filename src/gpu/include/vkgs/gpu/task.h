@@ -2,6 +2,7 @@
 #define VKGS_GPU_TASK_H
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <functional>
 
@@ -22,9 +23,12 @@ class VKGS_GPU_API Task {
   bool IsDone();
   void Wait();
 
+  const auto& objects() const noexcept { return objects_; }
+
  private:
   std::shared_ptr<Fence> fence_;
   std::vector<std::shared_ptr<Object>> objects_;
+  std::mutex mutex_;  // guards callback_, the task may be polled by the monitor and waited on by its owner
   std::function<void()> callback_;
 };
 
@@ -2,6 +2,7 @@
 #define VKGS_GPU_TASK_MONITOR_H
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <functional>
 
@@ -22,9 +23,14 @@ class VKGS_GPU_API TaskMonitor {
   std::shared_ptr<Task> Add(std::shared_ptr<Fence> fence, std::vector<std::shared_ptr<Object>> objects,
                             std::function<void()> callback = {});
 
+  // Bytes of buffers and images held only by tracked tasks, released by their owners and freed once the tasks are done
+  // and collected.
+  void GetPendingMemory(uint64_t* device, uint64_t* host);
+
  private:
   void gc();
 
+  std::mutex mutex_;
   std::vector<std::shared_ptr<Task>> tasks_;
   int rotation_index_ = 0;
 };
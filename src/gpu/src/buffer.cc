@@ -1,5 +1,8 @@
 #include "vkgs/gpu/buffer.h"
 
+#include <cstdint>
+#include <utility>
+
 #include "vkgs/gpu/device.h"
 
 namespace vkgs {
@@ -10,6 +13,73 @@ std::shared_ptr<Buffer> Buffer::Create(std::shared_ptr<Device> device, VkBufferU
   return std::make_shared<Buffer>(device, usage, size, host);
 }
 
+std::shared_ptr<Buffer> Buffer::Import(std::shared_ptr<Device> device, VkBufferUsageFlags usage, const void* ptr,
+                                       VkDeviceSize size, std::shared_ptr<void> owner) {
+  if (!device->external_memory_host() || ptr == nullptr || size == 0) return nullptr;
+
+  VkDeviceSize alignment = device->min_imported_host_pointer_alignment();
+  auto address = reinterpret_cast<uintptr_t>(ptr);
+  auto base_address = address / alignment * alignment;
+  VkDeviceSize offset = address - base_address;
+  VkDeviceSize aligned_size = (offset + size + alignment - 1) / alignment * alignment;
+  auto* base_ptr = reinterpret_cast<void*>(base_address);
+
+  VkMemoryHostPointerPropertiesEXT pointer_properties = {VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT};
+  if (vkGetMemoryHostPointerPropertiesEXT(*device, VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT, base_ptr,
+                                          &pointer_properties) != VK_SUCCESS) {
+    return nullptr;
+  }
+
+  std::shared_ptr<Buffer> buffer(new Buffer(device));
+
+  VkExternalMemoryBufferCreateInfo external_info = {VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO};
+  external_info.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+  VkBufferCreateInfo buffer_info = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+  buffer_info.pNext = &external_info;
+  buffer_info.size = aligned_size;
+  buffer_info.usage = usage;
+  if (vkCreateBuffer(*device, &buffer_info, NULL, &buffer->buffer_) != VK_SUCCESS) return nullptr;
+
+  VkMemoryRequirements requirements;
+  vkGetBufferMemoryRequirements(*device, buffer->buffer_, &requirements);
+  uint32_t memory_type_bits = requirements.memoryTypeBits & pointer_properties.memoryTypeBits;
+  if (memory_type_bits == 0 || requirements.size > aligned_size) return nullptr;
+
+  uint32_t memory_type_index = 0;
+  while (!(memory_type_bits & (1u << memory_type_index))) memory_type_index++;
+
+  VkImportMemoryHostPointerInfoEXT import_info = {VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT};
+  import_info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+  import_info.pHostPointer = base_ptr;
+  VkMemoryAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+  allocate_info.pNext = &import_info;
+  allocate_info.allocationSize = aligned_size;
+  allocate_info.memoryTypeIndex = memory_type_index;
+  if (vkAllocateMemory(*device, &allocate_info, NULL, &buffer->memory_) != VK_SUCCESS) return nullptr;
+  if (vkBindBufferMemory(*device, buffer->buffer_, buffer->memory_, 0) != VK_SUCCESS) return nullptr;
+
+  buffer->size_ = aligned_size;
+  buffer->offset_ = offset;
+  buffer->owner_ = std::move(owner);
+  return buffer;
+}
+
+std::shared_ptr<Buffer> Buffer::CreateAliased(std::shared_ptr<Buffer> memory, VkBufferUsageFlags usage,
+                                              VkDeviceSize offset, VkDeviceSize size) {
+  std::shared_ptr<Buffer> buffer(new Buffer(memory->device_));
+
+  VkBufferCreateInfo buffer_info = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+  buffer_info.size = size;
+  buffer_info.usage = usage;
+  vmaCreateAliasingBuffer2(memory->device_->allocator(), memory->allocation_, offset, &buffer_info, &buffer->buffer_);
+
+  buffer->size_ = size;
+  buffer->aliased_ = memory;
+  return buffer;
+}
+
+Buffer::Buffer(std::shared_ptr<Device> device) : device_(device) {}
+
 Buffer::Buffer(std::shared_ptr<Device> device, VkBufferUsageFlags usage, VkDeviceSize size, bool host)
     : device_(device), size_(size) {
   VkBufferCreateInfo buffer_info = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
@@ -28,9 +98,26 @@ Buffer::Buffer(std::shared_ptr<Device> device, VkBufferUsageFlags usage, VkDevic
     allocation_info.usage = VMA_MEMORY_USAGE_AUTO;
     vmaCreateBuffer(device_->allocator(), &buffer_info, &allocation_info, &buffer_, &allocation_, NULL);
   }
+  device_->AddTaggedMemory(tag_, host, size_);
+}
+
+void Buffer::set_tag(uint32_t tag) noexcept {
+  if (owns_memory()) {
+    device_->AddTaggedMemory(tag_, host(), -static_cast<int64_t>(size_));
+    device_->AddTaggedMemory(tag, host(), size_);
+  }
+  tag_ = tag;
 }
 
-Buffer::~Buffer() { vmaDestroyBuffer(device_->allocator(), buffer_, allocation_); }
+Buffer::~Buffer() {
+  if (memory_ != VK_NULL_HANDLE || allocation_ == VK_NULL_HANDLE) {
+    vkDestroyBuffer(*device_, buffer_, NULL);
+    vkFreeMemory(*device_, memory_, NULL);
+  } else {
+    device_->AddTaggedMemory(tag_, host(), -static_cast<int64_t>(size_));
+    vmaDestroyBuffer(device_->allocator(), buffer_, allocation_);
+  }
+}
 
 }  // namespace gpu
 }  // namespace vkgs
@@ -18,6 +18,7 @@ CommandPool::~CommandPool() { vkDestroyCommandPool(device_, command_pool_, NULL)
 std::shared_ptr<Command> CommandPool::Allocate() {
   VkCommandBuffer command_buffer;
 
+  std::lock_guard<std::mutex> lock(mutex_);
   if (command_buffers_.empty()) {
     VkCommandBufferAllocateInfo command_buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
     command_buffer_info.commandPool = command_pool_;
@@ -32,7 +33,10 @@ std::shared_ptr<Command> CommandPool::Allocate() {
   return std::make_shared<Command>(shared_from_this(), command_buffer);
 }
 
-void CommandPool::Free(VkCommandBuffer command_buffer) { command_buffers_.push_back(command_buffer); }
+void CommandPool::Free(VkCommandBuffer command_buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  command_buffers_.push_back(command_buffer);
+}
 
 }  // namespace gpu
 }  // namespace vkgs
@@ -2,6 +2,7 @@
 #define VKGS_GPU_COMMAND_POOL_H
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "volk.h"
@@ -27,6 +28,7 @@ class CommandPool : public std::enable_shared_from_this<CommandPool> {
   uint32_t queue_family_index_;
 
   VkCommandPool command_pool_ = VK_NULL_HANDLE;
+  std::mutex mutex_;  // Allocate and Free may be called from loader threads.
   std::vector<VkCommandBuffer> command_buffers_;
 };
 
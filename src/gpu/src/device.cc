@@ -1,5 +1,6 @@
 #include "vkgs/gpu/device.h"
 
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -122,6 +123,14 @@ Device::Device() {
   vkGetPhysicalDeviceProperties(physical_device_, &device_properties);
   device_name_ = device_properties.deviceName;
 
+  // Optional: subgroup ballot in compute shaders
+  VkPhysicalDeviceSubgroupProperties subgroup_properties = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES};
+  VkPhysicalDeviceProperties2 subgroup_properties2 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+  subgroup_properties2.pNext = &subgroup_properties;
+  vkGetPhysicalDeviceProperties2(physical_device_, &subgroup_properties2);
+  subgroup_ballot_ = (subgroup_properties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) &&
+                     (subgroup_properties.supportedOperations & VK_SUBGROUP_FEATURE_BALLOT_BIT);
+
   // Queue
   uint32_t queue_family_count = 0;
   vkGetPhysicalDeviceQueueFamilyProperties(physical_device_, &queue_family_count, NULL);
@@ -158,6 +167,10 @@ Device::Device() {
       transfer_queue_index = i;
   }
 
+  // Optional: timestamp queries on the compute queue
+  compute_timestamp_valid_bits_ = queue_family_properties[compute_queue_index].timestampValidBits;
+  timestamp_period_ = device_properties.limits.timestampPeriod;
+
   // Device
   float queue_priority = 1.0f;
   std::vector<VkDeviceQueueCreateInfo> queue_create_infos(3);
@@ -181,6 +194,30 @@ Device::Device() {
 #endif
   };
 
+  // Optional: import of host allocations as transfer sources, and memory budget queries
+  uint32_t available_extension_count = 0;
+  vkEnumerateDeviceExtensionProperties(physical_device_, NULL, &available_extension_count, NULL);
+  std::vector<VkExtensionProperties> available_extensions(available_extension_count);
+  vkEnumerateDeviceExtensionProperties(physical_device_, NULL, &available_extension_count,
+                                       available_extensions.data());
+  for (const auto& extension : available_extensions) {
+    if (std::strcmp(extension.extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0) {
+      VkPhysicalDeviceExternalMemoryHostPropertiesEXT external_memory_host_properties = {
+          VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT};
+      VkPhysicalDeviceProperties2 properties2 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+      properties2.pNext = &external_memory_host_properties;
+      vkGetPhysicalDeviceProperties2(physical_device_, &properties2);
+
+      device_extensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+      external_memory_host_ = true;
+      min_imported_host_pointer_alignment_ = external_memory_host_properties.minImportedHostPointerAlignment;
+    }
+    if (std::strcmp(extension.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0) {
+      device_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+      memory_budget_ = true;
+    }
+  }
+
   // VkPhysicalDeviceVulkan13Features
   VkPhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES};
@@ -233,6 +270,7 @@ Device::Device() {
   functions.vkGetDeviceProcAddr = vkGetDeviceProcAddr;
 
   VmaAllocatorCreateInfo allocator_info = {};
+  if (memory_budget_) allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
   allocator_info.physicalDevice = physical_device_;
   allocator_info.device = device_;
   allocator_info.instance = instance_;
@@ -267,5 +305,53 @@ std::shared_ptr<Fence> Device::AllocateFence() { return fence_pool_->Allocate();
 
 void Device::WaitIdle() { vkDeviceWaitIdle(device_); }
 
+void Device::GetDeviceLocalBudget(VkDeviceSize* usage, VkDeviceSize* budget) const {
+  const VkPhysicalDeviceMemoryProperties* memory_properties;
+  vmaGetMemoryProperties(allocator_, &memory_properties);
+  std::vector<VmaBudget> budgets(memory_properties->memoryHeapCount);
+  vmaGetHeapBudgets(allocator_, budgets.data());
+
+  *usage = 0;
+  *budget = 0;
+  for (uint32_t i = 0; i < memory_properties->memoryHeapCount; ++i) {
+    if (memory_properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+      *usage += budgets[i].usage;
+      *budget += budgets[i].budget;
+    }
+  }
+}
+
+void Device::GetAllocatedMemory(VkDeviceSize* device_allocated, VkDeviceSize* device_reserved,
+                                VkDeviceSize* host_allocated, VkDeviceSize* host_reserved) const {
+  const VkPhysicalDeviceMemoryProperties* memory_properties;
+  vmaGetMemoryProperties(allocator_, &memory_properties);
+  VmaTotalStatistics statistics;
+  vmaCalculateStatistics(allocator_, &statistics);
+
+  *device_allocated = 0;
+  *device_reserved = 0;
+  *host_allocated = 0;
+  *host_reserved = 0;
+  for (uint32_t i = 0; i < memory_properties->memoryHeapCount; ++i) {
+    const auto& heap_statistics = statistics.memoryHeap[i].statistics;
+    if (memory_properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+      *device_allocated += heap_statistics.allocationBytes;
+      *device_reserved += heap_statistics.blockBytes;
+    } else {
+      *host_allocated += heap_statistics.allocationBytes;
+      *host_reserved += heap_statistics.blockBytes;
+    }
+  }
+}
+
+void Device::AddTaggedMemory(uint32_t tag, bool host, int64_t size) noexcept {
+  auto& counter = host ? tagged_host_memory_[tag] : tagged_device_memory_[tag];
+  counter += size;
+}
+
+uint64_t Device::tagged_memory(uint32_t tag, bool host) const noexcept {
+  return host ? tagged_host_memory_[tag].load() : tagged_device_memory_[tag].load();
+}
+
 }  // namespace gpu
 }  // namespace vkgs
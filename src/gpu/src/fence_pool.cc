@@ -15,6 +15,7 @@ FencePool::~FencePool() {
 
 std::shared_ptr<Fence> FencePool::Allocate() {
   VkFence fence;
+  std::lock_guard<std::mutex> lock(mutex_);
   if (fences_.empty()) {
     VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
     vkCreateFence(device_, &fence_info, NULL, &fence);
@@ -25,7 +26,10 @@ std::shared_ptr<Fence> FencePool::Allocate() {
   return std::make_shared<Fence>(device_, shared_from_this(), fence);
 }
 
-void FencePool::Free(VkFence fence) { fences_.push_back(fence); }
+void FencePool::Free(VkFence fence) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  fences_.push_back(fence);
+}
 
 }  // namespace gpu
 }  // namespace vkgs
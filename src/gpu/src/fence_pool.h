@@ -2,6 +2,7 @@
 #define VKGS_GPU_FENCE_POOL_H
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "volk.h"
@@ -21,6 +22,7 @@ class FencePool : public std::enable_shared_from_this<FencePool> {
 
  private:
   VkDevice device_;
+  std::mutex mutex_;
   std::vector<VkFence> fences_;
 };
 
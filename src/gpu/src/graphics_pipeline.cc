@@ -8,7 +8,8 @@ namespace gpu {
 GraphicsPipeline::GraphicsPipeline(VkDevice device, VkPipelineLayout pipeline_layout, const uint32_t* vertex_shader,
                                    size_t vertex_shader_size, const uint32_t* fragment_shader,
                                    size_t fragment_shader_size, VkFormat format, VkFormat depth_format,
-                                   bool depth_write_enable, VkCompareOp depth_compare_op)
+                                   bool depth_write_enable, VkCompareOp depth_compare_op,
+                                   VkPrimitiveTopology topology)
     : device_(device) {
   // TODO: pipeline cache.
   VkPipelineCache pipeline_cache = VK_NULL_HANDLE;
@@ -46,7 +47,7 @@ GraphicsPipeline::GraphicsPipeline(VkDevice device, VkPipelineLayout pipeline_la
 
   VkPipelineInputAssemblyStateCreateInfo input_assembly_state = {
       VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
-  input_assembly_state.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+  input_assembly_state.topology = topology;
 
   VkPipelineViewportStateCreateInfo viewport_state = {VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO};
   viewport_state.viewportCount = 1;
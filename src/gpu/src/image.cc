@@ -1,5 +1,7 @@
 #include "vkgs/gpu/image.h"
 
+#include <stdexcept>
+
 #include "vkgs/gpu/device.h"
 
 namespace vkgs {
@@ -25,10 +27,14 @@ Image::Image(std::shared_ptr<Device> device, VkFormat format, uint32_t width, ui
   image_info.usage = usage;
   VmaAllocationCreateInfo allocation_info = {};
   allocation_info.usage = VMA_MEMORY_USAGE_AUTO;
-  VkResult result = vmaCreateImage(device_->allocator(), &image_info, &allocation_info, &image_, &allocation_, NULL);
+  VmaAllocationInfo vma_allocation_info;
+  VkResult result =
+      vmaCreateImage(device_->allocator(), &image_info, &allocation_info, &image_, &allocation_, &vma_allocation_info);
   if (result != VK_SUCCESS || image_ == VK_NULL_HANDLE) {
     throw std::runtime_error("Failed to create image: vmaCreateImage returned error");
   }
+  size_ = vma_allocation_info.size;
+  device_->AddTaggedMemory(tag_, false, size_);
 
   VkImageViewCreateInfo view_info = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
   view_info.image = image_;
@@ -51,7 +57,14 @@ Image::Image(std::shared_ptr<Device> device, VkFormat format, uint32_t width, ui
   vkCreateImageView(*device_, &view_info, nullptr, &image_view_);
 }
 
+void Image::set_tag(uint32_t tag) noexcept {
+  device_->AddTaggedMemory(tag_, false, -static_cast<int64_t>(size_));
+  device_->AddTaggedMemory(tag, false, size_);
+  tag_ = tag;
+}
+
 Image::~Image() {
+  device_->AddTaggedMemory(tag_, false, -static_cast<int64_t>(size_));
   vkDestroyImageView(*device_, image_view_, nullptr);
   vmaDestroyImage(device_->allocator(), image_, allocation_);
 }
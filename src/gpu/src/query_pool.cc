@@ -0,0 +1,27 @@
+#include "vkgs/gpu/query_pool.h"
+
+#include "vkgs/gpu/device.h"
+
+namespace vkgs {
+namespace gpu {
+
+std::shared_ptr<QueryPool> QueryPool::Create(std::shared_ptr<Device> device, uint32_t count) {
+  return std::make_shared<QueryPool>(device, count);
+}
+
+QueryPool::QueryPool(std::shared_ptr<Device> device, uint32_t count) : device_(device), count_(count) {
+  VkQueryPoolCreateInfo query_pool_info = {VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+  query_pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+  query_pool_info.queryCount = count;
+  vkCreateQueryPool(*device_, &query_pool_info, NULL, &query_pool_);
+}
+
+QueryPool::~QueryPool() { vkDestroyQueryPool(*device_, query_pool_, NULL); }
+
+void QueryPool::GetTimestamps(uint64_t* timestamps) {
+  vkGetQueryPoolResults(*device_, query_pool_, 0, count_, count_ * sizeof(uint64_t), timestamps, sizeof(uint64_t),
+                        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+}
+
+}  // namespace gpu
+}  // namespace vkgs
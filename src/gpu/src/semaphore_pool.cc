@@ -16,6 +16,7 @@ SemaphorePool::~SemaphorePool() {
 std::shared_ptr<Semaphore> SemaphorePool::Allocate() {
   std::pair<VkSemaphore, uint64_t> semaphore;
 
+  std::lock_guard<std::mutex> lock(mutex_);
   if (semaphores_.empty()) {
     VkSemaphoreTypeCreateInfo timeline_semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
     timeline_semaphore_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
@@ -33,7 +34,10 @@ std::shared_ptr<Semaphore> SemaphorePool::Allocate() {
   return std::make_shared<Semaphore>(device_, shared_from_this(), semaphore.first, semaphore.second);
 }
 
-void SemaphorePool::Free(VkSemaphore semaphore, uint64_t value) { semaphores_.emplace_back(semaphore, value); }
+void SemaphorePool::Free(VkSemaphore semaphore, uint64_t value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  semaphores_.emplace_back(semaphore, value);
+}
 
 }  // namespace gpu
 }  // namespace vkgs
@@ -2,6 +2,7 @@
 #define VKGS_GPU_SEMAPHORE_POOL_H
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "volk.h"
@@ -22,6 +23,7 @@ class SemaphorePool : public std::enable_shared_from_this<SemaphorePool> {
  private:
   VkDevice device_;
 
+  std::mutex mutex_;
   std::vector<std::pair<VkSemaphore, uint64_t>> semaphores_;
 };
 
@@ -12,6 +12,7 @@ Task::~Task() { Wait(); }
 
 bool Task::IsDone() {
   if (fence_->IsSignaled()) {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (callback_) {
       callback_();
       callback_ = {};
@@ -24,6 +25,7 @@ bool Task::IsDone() {
 void Task::Wait() {
   fence_->Wait();
 
+  std::lock_guard<std::mutex> lock(mutex_);
   if (callback_) {
     callback_();
     callback_ = {};
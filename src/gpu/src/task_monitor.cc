@@ -1,6 +1,8 @@
 #include "vkgs/gpu/task_monitor.h"
 
 #include "vkgs/gpu/task.h"
+#include "vkgs/gpu/buffer.h"
+#include "vkgs/gpu/image.h"
 
 namespace vkgs {
 namespace gpu {
@@ -11,6 +13,7 @@ TaskMonitor::~TaskMonitor() = default;
 
 std::shared_ptr<Task> TaskMonitor::Add(std::shared_ptr<Fence> fence, std::vector<std::shared_ptr<Object>> objects,
                                        std::function<void()> callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
   gc();
 
   auto task = std::make_shared<Task>(fence, std::move(objects), std::move(callback));
@@ -18,6 +21,23 @@ std::shared_ptr<Task> TaskMonitor::Add(std::shared_ptr<Fence> fence, std::vector
   return task;
 }
 
+void TaskMonitor::GetPendingMemory(uint64_t* device, uint64_t* host) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  *device = 0;
+  *host = 0;
+  for (const auto& task : tasks_) {
+    for (const auto& object : task->objects()) {
+      if (object.use_count() > 1) continue;
+      if (auto buffer = dynamic_cast<const Buffer*>(object.get())) {
+        if (buffer->owns_memory()) (buffer->host() ? *host : *device) += buffer->size();
+      } else if (auto image = dynamic_cast<const Image*>(object.get())) {
+        *device += image->size();
+      }
+    }
+  }
+}
+
 void TaskMonitor::gc() {
   constexpr int LOOP = 5;
 
@@ -46,7 +46,7 @@ class GUI {
   void RenderTitleScreen(VkCommandBuffer command_buffer, VkFramebuffer framebuffer,
                          uint32_t width, uint32_t height,
                          bool& showing_title_screen, std::string& pending_ply_path,
-                         std::function<std::string()> show_file_picker);
+                         std::function<std::string()> show_file_picker, float load_progress = -1.0f);
   void RenderStatsPanel(VkCommandBuffer command_buffer, VkFramebuffer framebuffer,
                         uint32_t width, uint32_t height,
                         bool showing_title_screen, bool& stats_panel_open,
@@ -25,7 +25,8 @@ class TitleScreen {
   void Initialize(SDL_Window* window);
   void RenderUI(std::string& pending_ply_path,
                 std::function<std::string()> show_file_picker,
-                std::function<ImTextureID(const std::string&, int, int)> load_svg_texture);
+                std::function<ImTextureID(const std::string&, int, int)> load_svg_texture,
+                float load_progress = -1.0f);  // Progress bar of a running load, hidden if negative
   bool HandleClick(int x, int y, int width, int height,
                    std::string& pending_ply_path,
                    std::function<std::string()> show_file_picker);
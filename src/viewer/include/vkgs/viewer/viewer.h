@@ -22,6 +22,7 @@ namespace vkgs {
 namespace core {
 class Renderer;
 class GaussianSplats;
+class LoadTask;
 }
 namespace gpu {
 class Device;
@@ -66,6 +67,10 @@ class Viewer {
 
   std::shared_ptr<core::GaussianSplats> splats_;
 
+  // Asynchronous loading, polled every frame
+  std::shared_ptr<core::LoadTask> load_task_;
+  std::vector<std::shared_ptr<core::LoadTask>> cancelled_load_tasks_;  // joined once done, off the UI thread's path
+
   uint32_t width_;
   uint32_t height_;
   bool should_close_ = false;
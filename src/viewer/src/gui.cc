@@ -211,7 +211,7 @@ void GUI::UpdateRenderPass(VkRenderPass render_pass) {
 void GUI::RenderTitleScreen(VkCommandBuffer command_buffer, VkFramebuffer framebuffer,
                             uint32_t width, uint32_t height,
                             bool& showing_title_screen, std::string& pending_ply_path,
-                            std::function<std::string()> show_file_picker) {
+                            std::function<std::string()> show_file_picker, float load_progress) {
   if (!vulkan_initialized_ || !title_screen_ || framebuffer == VK_NULL_HANDLE) return;
 
   // Set display size BEFORE starting the frame
@@ -228,7 +228,7 @@ void GUI::RenderTitleScreen(VkCommandBuffer command_buffer, VkFramebuffer frameb
   auto load_texture = [this](const std::string& path, int w, int h) -> ImTextureID {
     return LoadSVGTexture(path, w, h);
   };
-  title_screen_->RenderUI(pending_ply_path, show_file_picker, load_texture);
+  title_screen_->RenderUI(pending_ply_path, show_file_picker, load_texture, load_progress);
 
   // Render ImGui to Vulkan
   ImGui::Render();
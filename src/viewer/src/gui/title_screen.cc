@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 
@@ -55,7 +56,8 @@ void TitleScreen::Initialize(SDL_Window* window) {
 
 void TitleScreen::RenderUI(std::string& pending_ply_path,
                             std::function<std::string()> show_file_picker,
-                            std::function<ImTextureID(const std::string&, int, int)> load_svg_texture) {
+                            std::function<ImTextureID(const std::string&, int, int)> load_svg_texture,
+                            float load_progress) {
   if (!window_) return;
 
   // Set display size (should be set by caller before NewFrame)
@@ -336,6 +338,25 @@ void TitleScreen::RenderUI(std::string& pending_ply_path,
   ImGui::PopStyleColor(5);
   ImGui::End();
 
+  // Load progress bar below the buttons
+  if (load_progress >= 0.0f) {
+    float progress_height = 4.0f;
+    float progress_y = button_y + button_height * 0.5f + spacing_between_elements;
+    float progress = std::clamp(load_progress, 0.0f, 1.0f);
+    ImDrawList* fg_draw_list = ImGui::GetForegroundDrawList();
+    fg_draw_list->AddRectFilled(ImVec2(buttons_start_x, progress_y),
+                                ImVec2(buttons_start_x + total_buttons_width, progress_y + progress_height),
+                                IM_COL32(40, 40, 40, 255));
+    fg_draw_list->AddRectFilled(ImVec2(buttons_start_x, progress_y),
+                                ImVec2(buttons_start_x + total_buttons_width * progress, progress_y + progress_height),
+                                text_color_u32);
+
+    char progress_text[32];
+    std::snprintf(progress_text, sizeof(progress_text), "loading %d%%", static_cast<int>(progress * 100.0f));
+    float progress_text_x = (io.DisplaySize.x - ImGui::CalcTextSize(progress_text).x) * 0.5f;
+    fg_draw_list->AddText(ImVec2(progress_text_x, progress_y + progress_height + 10.0f), text_color_u32, progress_text);
+  }
+
   // Version text at bottom
   if (font_36_ && font_36_->IsLoaded()) {
     ImGui::PushFont(font_36_);
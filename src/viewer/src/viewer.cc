@@ -1,7 +1,6 @@
 #include "vkgs/viewer/viewer.h"
 
 #include <iostream>
-#include <fstream>
 #include <cmath>
 #include <cstring>
 #include <limits>
@@ -10,6 +9,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <chrono>
+#include <mutex>
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_vulkan.h>
@@ -40,6 +40,7 @@
 #include "vkgs/core/gaussian_splats.h"
 #include "vkgs/core/rendered_image.h"
 #include "vkgs/core/draw_options.h"
+#include "vkgs/core/load_task.h"
 #include "vkgs/gpu/device.h"
 #include "vkgs/gpu/queue.h"
 #include "vkgs/gpu/command.h"
@@ -53,82 +54,12 @@ namespace viewer {
 
 namespace {
 
-struct PlyBounds {
-  glm::vec3 min;
-  glm::vec3 max;
-  bool valid = false;
-};
-
-std::optional<PlyBounds> ComputeBoundsFromPly(const std::string& path) {
-  std::ifstream file(path, std::ios::binary);
-  if (!file) {
-    std::cerr << "Warning: Unable to open PLY file for bounds: " << path << std::endl;
-    return std::nullopt;
-  }
-
-  std::string line;
-  bool in_vertex_element = false;
-  size_t vertex_count = 0;
-  size_t property_count = 0;
-
-  while (std::getline(file, line)) {
-    if (!line.empty() && line.back() == '\r') line.pop_back();
-
-    if (line.rfind("element vertex", 0) == 0) {
-      in_vertex_element = true;
-      std::string count_str = line.substr(std::strlen("element vertex"));
-      try {
-        vertex_count = static_cast<size_t>(std::stoull(count_str));
-      } catch (...) {
-        vertex_count = 0;
-      }
-    } else if (line.rfind("element ", 0) == 0) {
-      in_vertex_element = false;
-    } else if (in_vertex_element && line.rfind("property", 0) == 0) {
-      ++property_count;
-    } else if (line == "end_header") {
-      break;
-    }
-  }
-
-  if (vertex_count == 0 || property_count < 3) {
-    std::cerr << "Warning: Invalid PLY header for bounds computation" << std::endl;
-    return std::nullopt;
-  }
-
-  const size_t vertex_stride = property_count * sizeof(float);
-  PlyBounds bounds;
-  bounds.min = glm::vec3(std::numeric_limits<float>::max());
-  bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
-
-  for (size_t i = 0; i < vertex_count; ++i) {
-    float xyz[3];
-    file.read(reinterpret_cast<char*>(xyz), sizeof(xyz));
-    if (!file) break;
-
-    glm::vec3 position(xyz[0], xyz[1], xyz[2]);
-    bounds.min.x = std::min(bounds.min.x, position.x);
-    bounds.min.y = std::min(bounds.min.y, position.y);
-    bounds.min.z = std::min(bounds.min.z, position.z);
-    bounds.max.x = std::max(bounds.max.x, position.x);
-    bounds.max.y = std::max(bounds.max.y, position.y);
-    bounds.max.z = std::max(bounds.max.z, position.z);
-
-    if (vertex_stride > sizeof(xyz)) {
-      file.seekg(static_cast<std::streamoff>(vertex_stride - sizeof(xyz)), std::ios::cur);
-    }
-  }
-
-  if (!file.good() && !file.eof()) {
-    std::cerr << "Warning: Failed to read PLY data for bounds" << std::endl;
-    return std::nullopt;
-  }
-
-  bounds.valid = true;
-  return bounds;
+// Waits for all queues. Holds the renderer mutex since a loader thread may be submitting.
+void WaitIdle(core::Renderer& renderer) {
+  std::lock_guard<std::mutex> lock(renderer.mutex());
+  renderer.device()->WaitIdle();
 }
 
-
 }  // namespace
 
 // Event handling will be done in Run() method using SDL3 event loop
@@ -244,7 +175,7 @@ Viewer::~Viewer() {
   VkDevice vk_device = device->device();
 
   // Wait for all operations to complete
-  device->WaitIdle();
+  WaitIdle(*renderer_);
 
   // Shutdown GUI (this will clean up ImGui Vulkan resources)
   if (gui_) {
@@ -451,7 +382,7 @@ void Viewer::RecreateSwapchainResources() {
   VkDevice vk_device = device->device();
 
   // Wait for all pending operations to complete before destroying resources
-  device->WaitIdle();
+  WaitIdle(*renderer_);
 
   // Destroy old ImGui framebuffers BEFORE recreating swapchain
   // (framebuffers depend on swapchain image views, so they must be destroyed first)
@@ -610,13 +541,13 @@ void Viewer::RenderFrame() {
   if (fb_width != static_cast<int>(width_) || fb_height != static_cast<int>(height_)) {
     width_ = fb_width;
     height_ = fb_height;
-    renderer_->device()->WaitIdle();
+    WaitIdle(*renderer_);
     RecreateSwapchainResources();
   }
 
   // Check if swapchain needs recreation
   if (swapchain_->ShouldRecreate()) {
-    renderer_->device()->WaitIdle();
+    WaitIdle(*renderer_);
     RecreateSwapchainResources();
   }
 
@@ -691,6 +622,9 @@ void Viewer::RenderFrame() {
   auto rendered_image = renderer_->Draw(splats_, draw_options, image_data_.data());
   rendered_image->Wait();
 
+  // The graphics queue and its command pool are shared with loader threads.
+  std::lock_guard<std::mutex> lock(renderer_->mutex());
+
   // Copy buffer to swapchain image (3D scene)
   auto gq = device->graphics_queue();
   auto& command = command_buffers_[image_index];
@@ -1016,13 +950,13 @@ void Viewer::RenderTitleScreen() {
   if (fb_width != static_cast<int>(width_) || fb_height != static_cast<int>(height_)) {
     width_ = fb_width;
     height_ = fb_height;
-    renderer_->device()->WaitIdle();
+    WaitIdle(*renderer_);
     RecreateSwapchainResources();
   }
 
   // Check if swapchain needs recreation
   if (swapchain_->ShouldRecreate()) {
-    renderer_->device()->WaitIdle();
+    WaitIdle(*renderer_);
     RecreateSwapchainResources();
   }
 
@@ -1053,7 +987,8 @@ void Viewer::RenderTitleScreen() {
   vkWaitForFences(vk_device, 1, &render_fence, VK_TRUE, UINT64_MAX);
   vkResetFences(vk_device, 1, &render_fence);
 
-  // Get command buffer for rendering
+  // Get command buffer for rendering. The graphics queue and its command pool are shared with loader threads.
+  std::lock_guard<std::mutex> lock(renderer_->mutex());
   auto gq = device->graphics_queue();
   auto& command = command_buffers_[image_index];
   if (!command) {
@@ -1102,8 +1037,9 @@ void Viewer::RenderTitleScreen() {
   if (gui_) {
     auto show_picker = [this]() -> std::string { return ShowFilePicker(); };
     VkFramebuffer framebuffer = imgui_framebuffers_[image_index];
+    float load_progress = load_task_ ? load_task_->progress() : -1.0f;
     gui_->RenderTitleScreen(command_buffer, framebuffer, width_, height_,
-                            showing_title_screen_, pending_ply_path_, show_picker);
+                            showing_title_screen_, pending_ply_path_, show_picker, load_progress);
   }
 
   // Transition swapchain image to present
@@ -1340,40 +1276,61 @@ void Viewer::Run(const std::string& ply_path) {
       ProcessControllerInput();
     }
 
-    // Check if a PLY file was selected
+    // Check if a PLY file was selected. Loading runs on a worker thread while the title screen shows progress;
+    // selecting another file cancels the current load.
     if (!pending_ply_path_.empty()) {
       std::string path_to_load = pending_ply_path_;
       pending_ply_path_.clear();
 
       std::cout << "Loading PLY file: " << path_to_load << std::endl;
 
-      if (auto bounds_opt = ComputeBoundsFromPly(path_to_load)) {
-        const auto& bounds = *bounds_opt;
-        if (bounds.valid) {
-          glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
-          std::cout << "Scene bounds min: (" << bounds.min.x << ", " << bounds.min.y << ", " << bounds.min.z
-                    << ") max: (" << bounds.max.x << ", " << bounds.max.y << ", " << bounds.max.z << ")" << std::endl;
-          camera_center_[0] = center.x;
-          camera_center_[1] = center.y;
-          camera_center_[2] = center.z;
-
-          glm::vec3 extents = bounds.max - bounds.min;
-          float diagonal = glm::length(extents);
-          std::cout << "Scene diagonal length: " << diagonal << std::endl;
-          if (!std::isfinite(diagonal) || diagonal <= 0.0f) diagonal = 10.0f;
-
-          camera_distance_ = std::max(5.0f, diagonal * 1.2f);
-          camera_near_ = std::max(0.01f, diagonal * 0.01f);
-          camera_far_ = std::max(camera_distance_ * 4.0f, diagonal * 4.0f);
-          camera_fov_ = 45.0f;
-          // Reset camera rotation to default view
-          camera_rotation_ = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);  // Identity quaternion
-        }
+      // The cancelled load is parked until its worker exits, so the UI thread does not join it.
+      if (load_task_) {
+        load_task_->Cancel();
+        cancelled_load_tasks_.push_back(std::move(load_task_));
+      }
+      splats_.reset();
+      load_task_ = renderer_->LoadFromPlyAsync(path_to_load);
+      showing_title_screen_ = true;
+    }
+
+    cancelled_load_tasks_.erase(std::remove_if(cancelled_load_tasks_.begin(), cancelled_load_tasks_.end(),
+                                               [](const auto& task) { return task->IsDone(); }),
+                                cancelled_load_tasks_.end());
+
+    if (load_task_ && load_task_->IsDone()) {
+      try {
+        splats_ = load_task_->Get();
+        std::cout << "Loaded " << splats_->size() << " gaussians" << std::endl;
+        showing_title_screen_ = false;
+      } catch (const std::exception& e) {
+        std::cerr << "Failed to load PLY file: " << e.what() << std::endl;
       }
 
-      splats_ = renderer_->LoadFromPly(path_to_load);
-      std::cout << "Loaded " << splats_->size() << " gaussians" << std::endl;
-      showing_title_screen_ = false;
+      // Frame the camera on the position bounds gathered by the load.
+      if (splats_ && load_task_->has_bounds()) {
+        glm::vec3 bounds_min = load_task_->bounds_min();
+        glm::vec3 bounds_max = load_task_->bounds_max();
+        glm::vec3 center = (bounds_min + bounds_max) * 0.5f;
+        std::cout << "Scene bounds min: (" << bounds_min.x << ", " << bounds_min.y << ", " << bounds_min.z
+                  << ") max: (" << bounds_max.x << ", " << bounds_max.y << ", " << bounds_max.z << ")" << std::endl;
+        camera_center_[0] = center.x;
+        camera_center_[1] = center.y;
+        camera_center_[2] = center.z;
+
+        glm::vec3 extents = bounds_max - bounds_min;
+        float diagonal = glm::length(extents);
+        std::cout << "Scene diagonal length: " << diagonal << std::endl;
+        if (!std::isfinite(diagonal) || diagonal <= 0.0f) diagonal = 10.0f;
+
+        camera_distance_ = std::max(5.0f, diagonal * 1.2f);
+        camera_near_ = std::max(0.01f, diagonal * 0.01f);
+        camera_far_ = std::max(camera_distance_ * 4.0f, diagonal * 4.0f);
+        camera_fov_ = 45.0f;
+        // Reset camera rotation to default view
+        camera_rotation_ = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);  // Identity quaternion
+      }
+      load_task_.reset();
     }
 
     if (showing_title_screen_) {
@@ -1384,7 +1341,9 @@ void Viewer::Run(const std::string& ply_path) {
     }
   }
 
-  renderer_->device()->WaitIdle();
+  load_task_.reset();
+  cancelled_load_tasks_.clear();
+  WaitIdle(*renderer_);
 }
 
 void Viewer::Close() {
@@ -0,0 +1,60 @@
+import math
+
+import numpy as np
+import splatstream as ss
+
+
+def random_splats(N: int, seed: int = 0):
+    rng = np.random.default_rng(seed)
+    quats = rng.normal(size=(N, 4))
+    quats /= np.linalg.norm(quats, axis=-1, keepdims=True)
+    return ss.gaussian_splats(
+        means=rng.normal(size=(N, 3)).astype(np.float32) * 2.5,
+        quats=quats.astype(np.float32),
+        scales=rng.uniform(0.01, 0.2, (N, 3)).astype(np.float32),
+        opacities=rng.uniform(0.1, 1.0, N).astype(np.float32),
+        colors=rng.uniform(-0.5, 0.5, (N, 16, 3)).astype(np.float32),
+    )
+
+
+def orbit_viewmats(count: int, radius: float | np.ndarray = 10.0):
+    """
+    radius: scalar, or (count) distances of the cameras from the origin.
+    """
+    radius = np.broadcast_to(radius, (count,))
+    viewmats = []
+    for i in range(count):
+        theta = 2.0 * math.pi * (i / count)
+        C2W = np.zeros((4, 4))
+        C2W[:3, 0] = np.array([-math.sin(theta), 0.0, -math.cos(theta)])
+        C2W[:3, 1] = -np.array([0.0, 1.0, 0.0])
+        C2W[:3, 2] = -np.array([math.cos(theta), 0.0, -math.sin(theta)])
+        C2W[:3, 3] = np.array([math.cos(theta), 0.0, -math.sin(theta)]) * radius[i]
+        C2W[3, 3] = 1.0
+        viewmats.append(np.linalg.inv(C2W))
+    return np.stack(viewmats)
+
+
+def vulkan_matrices(viewmats, K, width, height, near=0.01, far=100.0):
+    # Same conversion as ss.draw, for drawing one view with the renderer directly.
+    viewmats = (
+        np.array([[1, 0, 0, 0], [0, -1, 0, 0], [0, 0, -1, 0], [0, 0, 0, 1]]) @ viewmats
+    )
+    K = np.array([[2.0 / width, 0, -1], [0, -2.0 / height, 1], [0, 0, 1]]) @ K
+    projection = np.insert(K, 2, 0, axis=-1)
+    projection = np.insert(projection, 2, 0, axis=-2)
+    projection[2, 2] = far / (near - far)
+    projection[2, 3] = near * far / (near - far)
+    projection[3, 2] = -1
+    projection[3, 3] = 0
+    return (
+        np.ascontiguousarray(viewmats, dtype=np.float32),
+        np.ascontiguousarray(projection, dtype=np.float32),
+    )
+
+
+def psnr(a: np.ndarray, b: np.ndarray):
+    mse = np.mean((a.astype(np.float64) - b.astype(np.float64)) ** 2)
+    if mse == 0:
+        return math.inf
+    return 10.0 * math.log10(255.0**2 / mse)
@@ -0,0 +1,45 @@
+import numpy as np
+import splatstream as ss
+from splatstream.singleton_renderer import singleton_renderer
+
+from common import orbit_viewmats, psnr, random_splats, vulkan_matrices
+
+if __name__ == "__main__":
+    splats = random_splats(10000)
+
+    width = 96
+    height = 64
+    K = np.array([[64.0, 0.0, width / 2], [0.0, 64.0, height / 2], [0.0, 0.0, 1.0]])
+
+    # Checks that ss.draw, which records DrawBatch groups of up to kMaxViewCount (16)
+    # views, draws each view like a separate Renderer::Draw. 40 views make two full
+    # groups and an uneven last one.
+    B = 40
+    viewmats = orbit_viewmats(B)
+    backgrounds = np.random.default_rng(1).uniform(0.0, 1.0, (B, 3))
+
+    batch = ss.draw(splats, viewmats, K, width, height, backgrounds=backgrounds).numpy()
+    assert batch.shape == (B, height, width, 4)
+
+    views, projection = vulkan_matrices(viewmats, K, width, height)
+    for i in range(B):
+        image = np.empty((height, width, 4), dtype=np.uint8)
+        singleton_renderer.draw(
+            splats,
+            views[i],
+            projection,
+            width,
+            height,
+            backgrounds[i].astype(np.float32),
+            0.3,
+            -1,
+            image,
+        ).wait()
+        # A group of 16 views takes 4 bits of the depth key, so the batch sorts depths 2
+        # bits coarser than a single draw. Splats whose depths tie then blend in the
+        # order of the atomic counter, which is not deterministic. Compare with a PSNR
+        # threshold instead of bytes.
+        view_psnr = psnr(batch[i], image)
+        assert view_psnr >= 40.0, f"view {i} differs from draw, PSNR {view_psnr:.1f} dB"
+
+    print(f"draw_batch of {B} views matches {B} draws within 40 dB PSNR")
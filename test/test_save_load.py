@@ -0,0 +1,33 @@
+import os
+
+import numpy as np
+import splatstream as ss
+
+from common import orbit_viewmats, random_splats
+
+if __name__ == "__main__":
+    os.makedirs("test_save_load", exist_ok=True)
+
+    splats = random_splats(10000)
+    path = "test_save_load/splats.vkgs"
+    ss.save_splats(splats, path)
+
+    loaded = ss.load_splats(path)
+    assert loaded.size == splats.size
+
+    # Saving the loaded splats again writes the same file.
+    resaved_path = "test_save_load/resaved.vkgs"
+    ss.save_splats(loaded, resaved_path)
+    with open(path, "rb") as f, open(resaved_path, "rb") as g:
+        assert f.read() == g.read(), "resaved file differs"
+
+    width = 96
+    height = 64
+    K = np.array([[64.0, 0.0, width / 2], [0.0, 64.0, height / 2], [0.0, 0.0, 1.0]])
+    viewmats = orbit_viewmats(4)
+
+    images = ss.draw(splats, viewmats, K, width, height).numpy()
+    loaded_images = ss.draw(loaded, viewmats, K, width, height).numpy()
+    assert np.array_equal(images, loaded_images), "loaded splats draw differently"
+
+    print(f"save_splats/load_splats round trip of {splats.size} splats matches")
@@ -0,0 +1,28 @@
+import numpy as np
+import splatstream as ss
+
+from common import orbit_viewmats, random_splats
+
+if __name__ == "__main__":
+    splats = random_splats(10000)
+
+    width = 96
+    height = 64
+    K = np.array([[64.0, 0.0, width / 2], [0.0, 64.0, height / 2], [0.0, 0.0, 1.0]])
+
+    # Views from outside, and from inside the cloud where most splats are culled.
+    viewmats = orbit_viewmats(4, radius=np.array([10.0, 10.0, 0.5, 0.5]))
+
+    sorted_images = ss.draw(
+        splats, viewmats, K, width, height, sorted_projection=True
+    ).numpy()
+    point_order_images = ss.draw(
+        splats, viewmats, K, width, height, sorted_projection=False
+    ).numpy()
+
+    for i in range(len(viewmats)):
+        assert np.array_equal(
+            sorted_images[i], point_order_images[i]
+        ), f"view {i} differs between sorted and point-order projection"
+
+    print("sorted_projection on and off draw the same images")